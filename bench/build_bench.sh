@@ -0,0 +1,22 @@
+#!/usr/bin/bash
+
+BENCH="ezml_bench"
+TARGET="./build/$BENCH"
+LIB="../bin/static"
+SRC="$BENCH.cpp"
+
+mkdir -p ./build
+
+echo -e "Building the benchmarks: \033[93m$TARGET\033[0m"
+
+# -O3 -- max speed optimization, same as the library
+# -ffast-math -- same math optimization as the library, so timings match library builds
+# -fopenmp -- link OpenMP runtime used by the library
+
+CFLAGS="-fdiagnostics-color=always -g -O3 -ffast-math -fopenmp -std=c++17"
+INCLUDE="../include"
+
+if g++ $CFLAGS -I $INCLUDE $SRC -o $TARGET -L$LIB -lezml -larmadillo -llapack;
+    then echo -e "\033[92mSuccessfully built the benchmarks: \033[93m$TARGET\033[0m"; 
+    else echo -e "\033[91mError!\033[0m";
+fi
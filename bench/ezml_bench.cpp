@@ -0,0 +1,283 @@
+/**
+ * @file ezml_bench.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief Micro and macro benchmarks of models, solvers, transformers and metrics
+ * @version 0.1
+ * @date 2024-06-05
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Usage: `ezml_bench [--out results.json] [--repeats 5] [--quick] [--filter name]`
+ *
+ * Every benchmark is run over a sweep of number of rows n and number of features d,
+ * setup (i.e. copying features changed by `fit()`) is not timed.
+ * Throughput is reported in rows/s and, where arithmetic dominates, in GFLOP/s of nominal flop count.
+ * Results are printed as a table and written as JSON to track regressions.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <omp.h>
+#include <armadillo>
+#include "linreg_model.hpp"
+#include "logreg_model.hpp"
+#include "autoreg_model.hpp"
+#include "autoreg_extractor.hpp"
+#include "ols_solver.hpp"
+#include "qr_solver.hpp"
+#include "derivative_solver.hpp"
+#include "standard_scaler.hpp"
+#include "diff_loss_functions.hpp"
+#include "predict_functions.hpp"
+#include "metrics.hpp"
+#include "data_generator.hpp"
+
+namespace
+{
+    // Result of one benchmark at one point of the sweep
+    struct Result
+    {
+        std::string name;
+        std::string kind;
+        size_t n;
+        size_t d;
+        size_t repeats;
+        double seconds_min;
+        double seconds_median;
+        double flops;
+    };
+
+    // Command line options
+    struct Options
+    {
+        std::string out = "ezml_bench.json";
+        size_t repeats = 5;
+        bool quick = false;
+        std::string filter;
+    };
+
+    // Keeps results observable, so compiler does not drop benchmarked work
+    volatile double sink = 0.0;
+
+    // Number of iterations of derivative-based solvers, min derivative size is zero, so all of them are run
+    constexpr size_t NUM_ITER = 100;
+
+    // Number of thresholds of metrics curves
+    constexpr size_t NUM_THRESHOLDS = 101;
+
+    // Largest features matrix of the sweep, in elements (256 MB of doubles)
+    constexpr size_t MAX_ELEMS = size_t(1) << 25;
+
+    /**
+     * @brief Time `run` `repeats` times, calling untimed `setup` before every run.
+     *
+     * @return Result Min and median time of runs
+     */
+    template <typename Setup, typename Run>
+    Result measure(const std::string& name, const std::string& kind, const size_t n, const size_t d, const size_t repeats,
+                   const double flops, Setup&& setup, Run&& run)
+    {
+        std::vector<double> seconds;
+        // One warm-up run, not recorded
+        setup();
+        run();
+        for (size_t r = 0; r < repeats; ++r)
+        {
+            setup();
+            const auto start = std::chrono::steady_clock::now();
+            run();
+            const auto stop = std::chrono::steady_clock::now();
+            seconds.push_back(std::chrono::duration<double>(stop - start).count());
+        }
+        std::sort(seconds.begin(), seconds.end());
+        return Result{name, kind, n, d, repeats, seconds.front(), seconds[seconds.size() / 2], flops};
+    }
+
+    void print_header()
+    {
+        std::cout << std::left << std::setw(34) << "benchmark" << std::setw(7) << "kind"
+                  << std::right << std::setw(10) << "n" << std::setw(6) << "d"
+                  << std::setw(14) << "median, s" << std::setw(14) << "rows/s" << std::setw(10) << "GFLOP/s" << std::endl;
+    }
+
+    void print_result(const Result& result)
+    {
+        std::cout << std::left << std::setw(34) << result.name << std::setw(7) << result.kind
+                  << std::right << std::setw(10) << result.n << std::setw(6) << result.d
+                  << std::setw(14) << std::scientific << std::setprecision(3) << result.seconds_median
+                  << std::setw(14) << result.n / result.seconds_median << std::fixed << std::setw(10);
+        if (result.flops > 0.0)
+            std::cout << result.flops / result.seconds_median / 1e9;
+        else
+            std::cout << "-";
+        std::cout << std::defaultfloat << std::endl;
+    }
+
+    void write_json(const std::string& path, const std::vector<Result>& results)
+    {
+        std::ofstream file(path);
+        file << std::setprecision(9);
+        file << "{\n";
+        file << "  \"library\": \"ezml\",\n";
+        file << "  \"timestamp\": " << std::time(nullptr) << ",\n";
+        file << "  \"threads\": " << omp_get_max_threads() << ",\n";
+        file << "  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& result = results[i];
+            file << "    {\"name\": \"" << result.name << "\", \"kind\": \"" << result.kind << "\""
+                 << ", \"n\": " << result.n << ", \"d\": " << result.d << ", \"repeats\": " << result.repeats
+                 << ", \"seconds_min\": " << result.seconds_min << ", \"seconds_median\": " << result.seconds_median
+                 << ", \"rows_per_sec\": " << result.n / result.seconds_median << ", \"gflops\": ";
+            if (result.flops > 0.0)
+                file << result.flops / result.seconds_median / 1e9;
+            else
+                file << "null";
+            file << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        file << "  ]\n";
+        file << "}\n";
+        if (!file)
+            std::cerr << "\033[91mError!\033[0m Can not write " << path << std::endl;
+    }
+
+    Options parse_options(const int argc, char** argv)
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            if (!std::strcmp(argv[i], "--out") && i + 1 < argc)
+                options.out = argv[++i];
+            else if (!std::strcmp(argv[i], "--repeats") && i + 1 < argc)
+                options.repeats = std::max(std::stoul(argv[++i]), 1UL);
+            else if (!std::strcmp(argv[i], "--quick"))
+                options.quick = true;
+            else if (!std::strcmp(argv[i], "--filter") && i + 1 < argc)
+                options.filter = argv[++i];
+            else
+            {
+                std::cerr << "Usage: " << argv[0] << " [--out results.json] [--repeats 5] [--quick] [--filter name]" << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const Options options = parse_options(argc, argv);
+    const std::vector<size_t> ns = options.quick ? std::vector<size_t>{1000, 10000} : std::vector<size_t>{1000, 10000, 100000, 1000000};
+    const std::vector<size_t> ds = options.quick ? std::vector<size_t>{8, 32} : std::vector<size_t>{8, 32, 128};
+    const size_t repeats = options.repeats;
+    std::vector<Result> results;
+
+    // Run benchmark only if its name matches filter, print and collect result
+    auto bench = [&](const std::string& name, const std::string& kind, const size_t n, const size_t d, const double flops,
+                     auto&& setup, auto&& run)
+    {
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos)
+            return;
+        results.push_back(measure(name, kind, n, d, repeats, flops, setup, run));
+        print_result(results.back());
+    };
+    auto no_setup = [](){};
+
+    std::cout << "Benchmarking with " << omp_get_max_threads() << " threads, " << repeats << " repeats\n" << std::endl;
+    print_header();
+    for (const size_t n : ns)
+    {
+        for (const size_t d : ds)
+        {
+            if (n * d > MAX_ELEMS)
+                continue;
+            const double nd = static_cast<double>(n) * d;
+            const double dd = static_cast<double>(d) * d;
+
+            // Data: random N(0, 1) features, linear target with noise, and its sign as class, seeded for every point of the sweep
+            const DataGenerator generator(d, static_cast<unsigned int>(n + d));
+            Features X;
+            Target y;
+            generator.generate(n, X, y);
+            const Target y_class = arma::conv_to<Target>::from(y > arma::median(y));
+            Features X_fit;
+            Features X_out;
+            Target y_out;
+
+            // Macro: fit models
+            OLSSolver ols_solver;
+            LinRegModel ols_model(ols_solver);
+            bench("linreg_fit/ols", "macro", n, d, 4.0 * n * dd + 2.0 * dd * d,
+                  [&](){ X_fit = X; }, [&](){ sink = sink + ols_model.fit(X_fit, y).get_weights()[0]; });
+            QRSolver qr_solver;
+            LinRegModel qr_model(qr_solver);
+            bench("linreg_fit/qr", "macro", n, d, 2.0 * n * dd,
+                  [&](){ X_fit = X; }, [&](){ sink = sink + qr_model.fit(X_fit, y).get_weights()[0]; });
+            // Gradient is a sum over rows, so learning rate is scaled by rows to keep steps stable
+            DerivativeSolver linreg_solver(DiffLoss::MEAN_SQUARED_ERROR_LOSS_GRAD, 0.1 / n, NUM_ITER, 0.0, false);
+            LinRegModel derivative_model(linreg_solver);
+            bench("linreg_fit/derivative", "macro", n, d, NUM_ITER * 4.0 * nd,
+                  [&](){ X_fit = X; }, [&](){ sink = sink + derivative_model.fit(X_fit, y).get_weights()[0]; });
+            DerivativeSolver logreg_solver(DiffLoss::LOG_LIKELIHOOD_LOSS_GRAD, 1.0 / n, NUM_ITER, 0.0, false);
+            LogRegModel logreg_model(logreg_solver);
+            bench("logreg_fit/derivative", "macro", n, d, NUM_ITER * 4.0 * nd,
+                  [&](){ X_fit = X; }, [&](){ sink = sink + logreg_model.fit(X_fit, y_class).get_weights()[0]; });
+            StandardScaler scaler;
+            bench("standard_scaler/fit_transform", "macro", n, d, 6.0 * nd,
+                  [&](){ X_fit = X; }, [&](){ sink = sink + scaler.fit_transform(X_fit)(0, 0); });
+            // Order p of AR(p) is d, process is as long as number of rows
+            const TimeSeries process = generator.generate_process(n + d);
+            OLSSolver ar_solver;
+            AutoRegModel ar_model(ar_solver);
+            AutoRegExtractor extractor(d);
+            TimeSeries ar_process;
+            bench("autoreg_fit/ols", "macro", n, d, 4.0 * n * dd + 2.0 * dd * d,
+                  [&](){ ar_process = process; },
+                  [&]()
+                  {
+                      Features X_ar = extractor.extract_X(ar_process);
+                      const Target y_ar = extractor.extract_y(ar_process);
+                      sink = sink + ar_model.fit(X_ar, y_ar).get_weights()[0];
+                  });
+
+            // Micro: predict, transform and derivative with fitted models on raw features
+            const Weights w_fitted = qr_model.get_weights();
+            X_fit = X;
+            X_fit.insert_cols(0, Features(n, 1, arma::fill::ones));
+            bench("linreg_predict/qr", "micro", n, d, 2.0 * nd,
+                  no_setup, [&](){ qr_model.predict_into(X_fit, y_out); sink = sink + y_out[0]; });
+            bench("logreg_predict_proba", "micro", n, d, 2.0 * nd,
+                  no_setup, [&](){ logreg_model.predict_proba_into(X_fit, y_out); sink = sink + y_out[0]; });
+            bench("standard_scaler/transform", "micro", n, d, 2.0 * nd,
+                  no_setup, [&](){ scaler.transform_into(X, X_out); sink = sink + X_out(0, 0); });
+            bench("diff_loss/mse_grad", "micro", n, d, 4.0 * nd,
+                  no_setup, [&](){ sink = sink + DiffLoss::mean_squared_error_loss_grad(w_fitted, X_fit, y)[0]; });
+            bench("data_generator/fill", "micro", n, d, 0.0,
+                  [&](){ X_out.set_size(n, d); y_out.set_size(n); }, [&](){ generator.fill(0, X_out, y_out); sink = sink + y_out[0]; });
+            bench("diff_loss/log_likelihood_grad", "micro", n, d, 4.0 * nd,
+                  no_setup, [&](){ sink = sink + DiffLoss::log_likelihood_loss_grad(w_fitted, X_fit, y_class)[0]; });
+        }
+
+        // Micro: metrics curves do not depend on number of features, so they are swept over rows only
+        arma::arma_rng::set_seed(n);
+        const Target y_true = arma::conv_to<Target>::from(Target(n, arma::fill::randu) > 0.5);
+        const Target y_proba(n, arma::fill::randu);
+        bench("metrics/roc_curve", "micro", n, 1, 0.0,
+              no_setup, [&](){ sink = sink + Metrics::roc_curve(y_true, y_proba, NUM_THRESHOLDS).first[0]; });
+        bench("metrics/pr_curve", "micro", n, 1, 0.0,
+              no_setup, [&](){ sink = sink + Metrics::pr_curve(y_true, y_proba, NUM_THRESHOLDS).first[0]; });
+    }
+
+    write_json(options.out, results);
+    std::cout << "\nResults written to: \033[93m" << options.out << "\033[0m" << std::endl;
+
+    return EXIT_SUCCESS;
+}
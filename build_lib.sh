@@ -7,8 +7,10 @@ TARGET="./bin/static"
 
 # -O3: max speed optimization
 # -ffast-math: math optimization, again for speed
+# -fopenmp: run parallel parts (i.e. Monte Carlo simulation) with OpenMP
+# $EZML_CFLAGS: extra flags, i.e. `EZML_CFLAGS=-DEZML_STATS ./build_lib.sh` records per-phase stats, see `get_stats()`
 
-CFLAGS="-fdiagnostics-color=always -c -g -O3 -ffast-math -std=c++17 -Wall"
+CFLAGS="-fdiagnostics-color=always -c -g -O3 -ffast-math -fopenmp -std=c++17 -Wall $EZML_CFLAGS"
 INCLUDE="./include"
 SRC="./src"
 
@@ -16,12 +18,30 @@ if
     g++ $CFLAGS -I $INCLUDE $SRC/base_model.cpp -o $TARGET/base_model.o -larmadillo -llapack;
     g++ $CFLAGS -I $INCLUDE $SRC/linreg_model.cpp -o $TARGET/linreg_model.o -larmadillo -llapack;
     g++ $CFLAGS -I $INCLUDE $SRC/logreg_model.cpp -o $TARGET/logreg_model.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/softmax_reg_model.cpp -o $TARGET/softmax_reg_model.o -larmadillo -llapack;
     g++ $CFLAGS -I $INCLUDE $SRC/base_solver.cpp -o $TARGET/base_solver.o -larmadillo -llapack;
     g++ $CFLAGS -I $INCLUDE $SRC/ols_solver.cpp -o $TARGET/ols_solver.o -larmadillo -llapack;
     g++ $CFLAGS -I $INCLUDE $SRC/qr_solver.cpp -o $TARGET/qr_solver.o -larmadillo -llapack;
     g++ $CFLAGS -I $INCLUDE $SRC/derivative_solver.cpp -o $TARGET/derivative_solver.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/typed_derivative_solver.cpp -o $TARGET/typed_derivative_solver.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/ridge_solver.cpp -o $TARGET/ridge_solver.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/elastic_net_solver.cpp -o $TARGET/elastic_net_solver.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/yule_walker_solver.cpp -o $TARGET/yule_walker_solver.o -larmadillo -llapack;
     g++ $CFLAGS -I $INCLUDE $SRC/base_transformer.cpp -o $TARGET/base_transformer.o -larmadillo -llapack;
     g++ $CFLAGS -I $INCLUDE $SRC/standard_scaler.cpp -o $TARGET/standard_scaler.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/autoreg_extractor.cpp -o $TARGET/autoreg_extractor.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/autoreg_model.cpp -o $TARGET/autoreg_model.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/autoreg_batch.cpp -o $TARGET/autoreg_batch.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/cross_validator.cpp -o $TARGET/cross_validator.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/halving_search.cpp -o $TARGET/halving_search.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/pipeline.cpp -o $TARGET/pipeline.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/mapped_file.cpp -o $TARGET/mapped_file.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/csv_loader.cpp -o $TARGET/csv_loader.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/columnar_dataset.cpp -o $TARGET/columnar_dataset.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/block_source.cpp -o $TARGET/block_source.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/data_generator.cpp -o $TARGET/data_generator.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/stats.cpp -o $TARGET/stats.o -larmadillo -llapack;
+    g++ $CFLAGS -I $INCLUDE $SRC/trace.cpp -o $TARGET/trace.o -larmadillo -llapack;
 
 then echo -e "\033[92mSuccessfully built the object files\033[0m"; 
     else echo -e "\033[91mError!\033[0m";
@@ -32,12 +52,30 @@ if
     ar rcs $TARGET/libezml.a $TARGET/base_model.o \
                              $TARGET/linreg_model.o \
                              $TARGET/logreg_model.o \
+                             $TARGET/softmax_reg_model.o \
                              $TARGET/base_solver.o \
                              $TARGET/ols_solver.o \
                              $TARGET/qr_solver.o \
                              $TARGET/derivative_solver.o \
+                             $TARGET/typed_derivative_solver.o \
+                             $TARGET/ridge_solver.o \
+                             $TARGET/elastic_net_solver.o \
+                             $TARGET/yule_walker_solver.o \
                              $TARGET/base_transformer.o \
-                             $TARGET/standard_scaler.o;
+                             $TARGET/standard_scaler.o \
+                             $TARGET/autoreg_extractor.o \
+                             $TARGET/autoreg_model.o \
+                             $TARGET/autoreg_batch.o \
+                             $TARGET/cross_validator.o \
+                             $TARGET/halving_search.o \
+                             $TARGET/pipeline.o \
+                             $TARGET/mapped_file.o \
+                             $TARGET/csv_loader.o \
+                             $TARGET/columnar_dataset.o \
+                             $TARGET/block_source.o \
+                             $TARGET/data_generator.o \
+                             $TARGET/stats.o \
+                             $TARGET/trace.o;
 then echo -e "\033[92mSuccessfully built the static library $TARGET/libezml.a\033[0m"; 
     else echo -e "\033[91mError!\033[0m";
 fi
@@ -5,6 +5,7 @@
 #include "ols_solver.hpp"
 #include "qr_solver.hpp"
 #include "derivative_solver.hpp"
+#include "yule_walker_solver.hpp"
 #include "diff_loss_functions.hpp"
 
 int main()
@@ -57,8 +58,33 @@ int main()
     size_t num_periods = 100;
     TimeSeries process_pred = ar_model.predict(X, num_periods);
     process_pred.print("\nForecasted process:");
+
+    // Simulate many paths in parallel to get forecast distribution
+    size_t num_paths = 1000;
+    unsigned int seed = 42;
+    ForecastBands bands = ar_model.simulate(X, num_periods, num_paths, seed, {0.05, 0.5, 0.95});
+    bands.first.brief_print("\nMean forecasted path:");
+    bands.second.brief_print("\nForecast quantiles (5%, 50%, 95%):");
     
     std::cout << "\nCoef corr between X and y: " << arma::cor(X, y);
 
+    // Fit AR(p) model directly on time series with Yule-Walker solver, i.e. without lag matrix
+    YuleWalkerSolver yw_solver;
+    AutoRegModel yw_model(yw_solver);
+    std::cout << "\n\nFitting with: " << yw_model.get_name() << std::endl;
+    yw_model.fit(process, p);
+    std::cout << "\nLearned weights (w_0, ..., w_" << arma::size(yw_model.get_weights()).n_cols - 1 << "): " << yw_model.get_weights();
+    std::cout << "\nLearned sigma: " << yw_model.get_sigma() << std::endl;
+    // Forecast following the last p values of time series, since there is no lag matrix
+    TimeSeries yw_pred = yw_model.forecast(process, num_periods, seed);
+    yw_pred.print("\nForecasted process:");
+
+    // Select best order up to max_p by AIC (or BIC) in one sweep
+    size_t max_p = 24;
+    InfoCriteria criteria = yw_model.select_order(process, max_p, Criterion::AIC);
+    criteria.first.print("\nAIC of orders 1 ... max_p:");
+    criteria.second.print("\nBIC of orders 1 ... max_p:");
+    std::cout << "\nBest order by AIC: " << yw_model.get_order() << std::endl;
+
     return EXIT_SUCCESS;
 }
\ No newline at end of file
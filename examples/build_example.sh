@@ -10,8 +10,9 @@ mkdir -p ./build
 echo -e "Building the example: \033[93m$TARGET\033[0m"
 
 # -O3 -- max speed optimization
+# -fopenmp -- link OpenMP runtime used by the library
 
-CFLAGS="-fdiagnostics-color=always -g -O3 -std=c++17"
+CFLAGS="-fdiagnostics-color=always -g -O3 -fopenmp -std=c++17"
 INCLUDE="../include"
 
 if g++ $CFLAGS -I $INCLUDE $SRC -o $TARGET -L$LIB -lezml -larmadillo -llapack;
@@ -5,21 +5,30 @@
 #include "ols_solver.hpp"
 #include "qr_solver.hpp"
 #include "derivative_solver.hpp"
+#include "typed_derivative_solver.hpp"
+#include "ridge_solver.hpp"
+#include "elastic_net_solver.hpp"
 #include "diff_loss_functions.hpp"
 #include "metrics.hpp"
+#include "cross_validator.hpp"
+#include "halving_search.hpp"
+#include "pipeline.hpp"
+#include "csv_loader.hpp"
+#include "columnar_dataset.hpp"
+#include "block_source.hpp"
 #include "exceptions.hpp"
+#include "trace.hpp"
 
 int main()
 {
     // Regression: multiple features
     // Data: https://www.kaggle.com/datasets/ryanholbrook/dl-course-data?select=housing.csv
-    Features data;
-    data.load("./data/housing.csv", arma::csv_ascii);
-    // Skip the header
-    data.shed_row(0);
-    Features X = data.cols(1, 8);
+    // Load only needed columns in parallel, skipping the header
+    CSVLoader loader({1, 2, 3, 4, 5, 6, 7, 8} /* features */, 9 /* target */, 1 /* header rows */);
+    Features X;
+    Target y;
+    loader.load("./data/housing.csv", X, y);
     X.brief_print("\nFeatures: MedInc, HouseAge, AveRooms, AveBedrms, Population, AveOccup, Latitude, Longitude");
-    Target y = data.cols(9, 9);
     y.brief_print("\nTarget: log(MedHouseVal/1000)");
 
     // Fit linear regression model with either OLS, or QR, or derivative solver
@@ -50,6 +59,8 @@ int main()
     //DerivativeSolver solver(DiffLoss::MEAN_SQUARED_ERROR_LOSS_GRAD, lr, max_iter, max_deriv_size, verbose);
     // MSE newton
     //DerivativeSolver solver(DiffLoss::MEAN_SQUARED_ERROR_LOSS_NEWTON, lr, max_iter, max_deriv_size, verbose);
+    // MSE grad, loss type known at compile time, so it is inlined into optimization loop
+    //TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad> solver(lr, max_iter, max_deriv_size, verbose);
     LinRegModel lr_model(solver);
     // Try to predict with unfitted model
     try
@@ -86,5 +97,110 @@ int main()
     std::cout << "\nResiduals stddev: " << arma::stddev(residuals);
     std::cout << "\nCoef corr between residuals and predictions: " << arma::cor(y_pred, residuals) << std::endl;
 
+    // Fit ridge regression for a whole grid of lambdas at once, weights of lambda with min GCV error are used
+    RidgeSolver ridge_solver(arma::logspace(-3, 3, 13));
+    LinRegModel ridge_model(ridge_solver);
+    Features X_ridge = std_scaler.transform(X);
+    ridge_model.fit(X_ridge, y);
+    ridge_model.get_solver().get_gcv().t().print("\nRidge GCV per lambda:");
+    ridge_model.get_solver().get_path().brief_print("\nRidge weights path (one row per lambda):");
+    std::cout << "\nRidge weights: " << ridge_model.get_weights();
+
+    // Fit Lasso (alpha = 1) along decreasing grid of lambdas with warm starts
+    ElasticNetSolver lasso_solver(arma::logspace(0, -4, 21), 1.0 /* alpha */);
+    LinRegModel lasso_model(lasso_solver);
+    Features X_lasso = std_scaler.transform(X);
+    lasso_model.fit(X_lasso, y);
+    lasso_model.get_solver().get_path().brief_print("\nLasso weights path (one row per lambda):");
+    std::cout << "\nLasso weights: " << lasso_model.get_weights();
+
+    // Cross-validate OLS (lambda = 0) on original features with k folds
+    size_t num_folds = 5;
+    CrossValidator cv(num_folds /*, lambda = 0.0 */);
+    std::cout << "\nCross-validating with: " << cv.get_name() << std::endl;
+    CVScores scores = cv.evaluate(X, y);
+    scores.first.print("\nMSE per fold:");
+    scores.second.print("\nR2 per fold:");
+
+    // Tune derivative solver with successive halving on train/validation split of normalized features
+    Features X_scaled = std_scaler.transform(X);
+    size_t num_train = X_scaled.n_rows * 4 / 5;
+    HalvingSearch search(DiffLoss::MEAN_SQUARED_ERROR_LOSS_GRAD, Predict::linreg, Metrics::mse,
+                         {1e-1, 3e-2, 1e-2, 3e-3, 1e-3}, {1e-4, 1e-6},
+                         10 /* min_iter */, 1000 /* max_iter */, 3 /* eta */);
+    std::cout << "\nSearching with: " << search.get_name() << std::endl;
+    search.fit(X_scaled.head_rows(num_train), y.head(num_train), X_scaled.tail_rows(X_scaled.n_rows - num_train), y.tail(y.n_rows - num_train));
+    search.get_best_config().print("\nBest config (learning rate, iterations, min derivative size):");
+    std::cout << "\nBest validation MSE: " << search.get_best_score() << std::endl;
+
+    // Gradient descent with early stopping on the same split: score every 10 iterations, stop after 5 scores without improvement
+    // State is checkpointed every 100 iterations, so rerun after interruption resumes from the last checkpoint
+    DerivativeSolver es_solver(DiffLoss::MEAN_SQUARED_ERROR_LOSS_GRAD, 1e-5, 10000, 1e-6, false);
+    es_solver.set_early_stopping(Predict::linreg, Metrics::mse, 10 /* eval every */, 5 /* patience */)
+             .set_checkpoint("./data/housing_solver.ckpt", 100 /* checkpoint every */);
+    LinRegModel es_model(es_solver);
+    Features X_es_train = X_scaled.head_rows(num_train);
+    // Record fit with every solver iteration as trace, open it in chrome://tracing or https://ui.perfetto.dev
+    Trace::start("./data/housing_trace.json");
+    es_model.fit(X_es_train, y.head(num_train), X_scaled.tail_rows(X_scaled.n_rows - num_train), y.tail(y.n_rows - num_train));
+    Trace::stop();
+    std::cout << "\nEarly stopping best validation MSE: " << es_model.get_solver().get_best_score() 
+              << " at iter " << es_model.get_solver().get_best_iter() << std::endl;
+    // Time of phases, allocations and derivative norms per iteration are recorded, if library is built with `EZML_CFLAGS=-DEZML_STATS`
+    for (const auto& [phase, stats] : es_model.get_solver().get_stats().phases)
+        std::cout << "\nPhase " << phase << ": " << stats.seconds << " s in " << stats.calls << " calls";
+    std::cout << "\nIterations: " << es_model.get_solver().get_stats().num_iter << std::endl;
+
+    // Report convergence of every iteration to callback instead of printing, stop as soon as derivative is small enough
+    size_t num_reported = 0;
+    DerivativeSolver cb_solver(DiffLoss::MEAN_SQUARED_ERROR_LOSS_GRAD, 1e-5, 1000, 1e-6, false);
+    cb_solver.set_callback([&num_reported](const IterationInfo& info)
+                           {
+                               ++num_reported;
+                               return info.derivative_norm < 1e-1;
+                           }, Predict::linreg, Metrics::mse);
+    LinRegModel cb_model(cb_solver);
+    Features X_cb = X_scaled;
+    cb_model.fit(X_cb, y);
+    std::cout << "\nIterations reported to callback: " << num_reported << std::endl;
+
+    // Retrain on all rows starting from weights fitted above instead of Gaussian noise, so few iterations are needed
+    // Next fits of the same model start from its own weights (warm start), cold starts are seeded for reproducibility
+    DerivativeSolver ws_solver(DiffLoss::MEAN_SQUARED_ERROR_LOSS_GRAD, 1e-5, 100, 1e-6, false);
+    LinRegModel ws_model(ws_solver);
+    ws_model.set_seed(42);
+    ws_model.set_warm_start(true);
+    ws_model.set_initial_weights(es_model.get_weights());
+    Features X_ws = X_scaled;
+    ws_model.fit(X_ws, y);
+    std::cout << "\nWarm-started weights: " << ws_model.get_weights();
+
+    // Chain scaler and model, scaling is folded into weights, so raw features are scored directly
+    StandardScaler pipe_scaler;
+    LinRegModel pipe_model(solver);
+    Pipeline pipeline(pipe_scaler, pipe_model);
+    std::cout << "\nFitting with: " << pipeline.get_name() << std::endl;
+    pipeline.fit(X, y);
+    pipeline.get_weights().t().print("\nFolded weights (raw features):");
+    std::cout << "\nPipeline MSE on raw features: " << Metrics::mse(y, pipeline.predict(X)) << std::endl;
+
+    // Cache selected CSV columns as binary columnar dataset once, then reopen it without parsing
+    ColumnarDataset::convert("./data/housing.csv", loader, "./data/housing.ezml");
+    ColumnarDataset dataset("./data/housing.ezml");
+    std::cout << "\nOpened " << dataset.get_name() << " with " << dataset.get_num_rows() << " rows and " << dataset.get_num_features() << " features" << std::endl;
+    // Features view the mapped file, `fit()` moves them to own memory when adding dummy feature
+    Features X_cached = dataset.get_features();
+    Target y_cached = dataset.get_target();
+    LinRegModel cached_model(solver);
+    cached_model.fit(X_cached, y_cached);
+    std::cout << "\nWeights fitted on cached dataset: " << cached_model.get_weights();
+
+    // Stream cached dataset in blocks of rows, as if it did not fit in memory, and fit in one pass
+    BlockSource source(dataset, 4096 /* block rows */);
+    std::cout << "\nStreaming with: " << source.get_name() << " in " << source.get_num_blocks() << " blocks" << std::endl;
+    LinRegModel streamed_model(solver);
+    streamed_model.fit(source);
+    std::cout << "\nWeights fitted on streamed blocks: " << streamed_model.get_weights();
+
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -5,18 +5,18 @@
 #include "derivative_solver.hpp"
 #include "diff_loss_functions.hpp"
 #include "metrics.hpp"
+#include "csv_loader.hpp"
 
 int main()
 {
     // Classification: multiple features
-    Features data;
     //Data: https://www.kaggle.com/datasets/nimapourmoradi/raisin-binary-classification
-    data.load("./data/Raisin_Dataset.csv", arma::csv_ascii);
-    // Skip the header
-    data.shed_row(0);
-    Features X = data.cols(0, 6);
+    // Load only needed columns in parallel, skipping the header
+    CSVLoader loader({0, 1, 2, 3, 4, 5, 6} /* features */, 7 /* target */, 1 /* header rows */);
+    Features X;
+    Target y;
+    loader.load("./data/Raisin_Dataset.csv", X, y);
     X.brief_print("\nFeatures: Area, MajorAxisLength, MinorAxisLength, Eccentricity, ConvexArea, Extent, Perimeter");
-    Target y = data.cols(7, 7);
     y.brief_print("\nTarget: 1 = Kecimen, 0 = Besni");
 
     // Fit logistic regression model with derivative solver
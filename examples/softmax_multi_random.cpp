@@ -0,0 +1,58 @@
+#include <iostream>
+#include <armadillo>
+#include "standard_scaler.hpp"
+#include "softmax_reg_model.hpp"
+#include "derivative_solver.hpp"
+#include "typed_derivative_solver.hpp"
+#include "diff_loss_functions.hpp"
+#include "metrics.hpp"
+
+int main()
+{
+    // Classification: multiple classes
+    // Data: three Gaussian blobs N(center_k, 1) in 2D, labeled 0, 1, 2
+    arma::arma_rng::set_seed(42);
+    const size_t num_per_class = 200;
+    const Features centers = {{0.0, 0.0}, {4.0, 0.0}, {2.0, 4.0}};
+    Features X(3 * num_per_class, 2);
+    Target y(3 * num_per_class);
+    for (size_t k = 0; k < centers.n_rows; ++k)
+    {
+        X.rows(k * num_per_class, (k + 1) * num_per_class - 1) = arma::randn(num_per_class, 2) + arma::repmat(centers.row(k), num_per_class, 1);
+        y.subvec(k * num_per_class, (k + 1) * num_per_class - 1).fill(static_cast<double>(k));
+    }
+    X.brief_print("\nFeatures: x1, x2");
+    y.brief_print("\nTarget: class 0, 1, 2");
+
+    // Normalize features first to improve convergence of gradient descent
+    StandardScaler std_scaler;
+    Features X_norm = std_scaler.fit_transform(X);
+
+    double lr = 1e-3; // Gradient is summed over 600 observations
+    size_t max_iter = 1000;
+    double max_deriv_size = 1e-2;
+    bool verbose = false;
+    // Cross-entropy grad: all classes are trained at once in one pass per iteration
+    DerivativeSolver solver(DiffLoss::CROSS_ENTROPY_LOSS_GRAD, lr, max_iter, max_deriv_size, verbose);
+    // Same loss as compile-time functor type, no indirect call per iteration
+    //TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad> solver(lr, max_iter, max_deriv_size, verbose);
+    SoftmaxRegModel sm_model(solver);
+
+    // Fit softmax model
+    // Note: `fit()` changes features matrix, but `X_norm` is already a copy of original `X`
+    std::cout << "\nFitting with: " << sm_model.get_name() << std::endl;
+    sm_model.fit(X_norm, y);
+    sm_model.get_weights().print("\nLearned weights (one column per class):");
+    std::cout << "\nNumber of classes: " << sm_model.get_num_classes() << std::endl;
+
+    // Make predictions -- probabilities of all classes with one matrix product, then classify
+    Probabilities y_pred_proba = sm_model.predict_proba(X_norm);
+    y_pred_proba.brief_print("\nPredicted probabilities:");
+    Target y_pred = sm_model.predict(X_norm);
+    y_pred.brief_print("\nPredicted classes:");
+
+    // Compute metrics
+    std::cout << "\nAccuracy: " << Metrics::accuracy(y, y_pred) << std::endl;
+
+    return EXIT_SUCCESS;
+}
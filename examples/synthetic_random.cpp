@@ -0,0 +1,98 @@
+#include <iostream>
+#include <string>
+#include <armadillo>
+#include "data_generator.hpp"
+#include "linreg_model.hpp"
+#include "logreg_model.hpp"
+#include "autoreg_model.hpp"
+#include "ols_solver.hpp"
+#include "qr_solver.hpp"
+#include "derivative_solver.hpp"
+#include "yule_walker_solver.hpp"
+#include "diff_loss_functions.hpp"
+#include "columnar_dataset.hpp"
+#include "block_source.hpp"
+#include "metrics.hpp"
+#include "exceptions.hpp"
+
+int main(int argc, char** argv)
+{
+    // Synthetic data with known true weights, reproducible for the same seed
+    // Number of rows streamed to disk can be passed as argument, i.e. `./build/synthetic_random 100000000`
+    size_t num_rows = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+    size_t num_features = 8;
+    unsigned int seed = 42;
+
+    // Regression: multiple correlated features, cond(X^T X) = 1e4, half of true weights are zero
+    {
+        DataGenerator generator(num_features, seed, Link::IDENTITY, 1e4 /* condition number */, 0.5 /* sparsity */);
+        std::cout << "\nGenerating with: " << generator.get_name() << std::endl;
+        Features X;
+        Target y;
+        // Rows are generated in parallel, in memory
+        generator.generate(10000, X, y);
+        X.brief_print("\nFeatures: correlated N(0, 1)");
+        y.brief_print("\nTarget: linear with N(0, 1) noise");
+        std::cout << "\nTrue weights: " << generator.get_weights();
+        std::cout << "\nCondition number of X^T X: " << arma::cond(X.t() * X) << std::endl;
+        QRSolver solver;
+        LinRegModel lr_model(solver);
+        lr_model.fit(X, y);
+        std::cout << "\nLearned weights: " << lr_model.get_weights();
+    }
+
+    // Classification: 20% of class 1
+    {
+        DataGenerator generator(num_features, seed, Link::LOGIT, 1.0 /* condition number */, 0.0 /* sparsity */, 1.0 /* noise */, 0.2 /* balance */);
+        Features X;
+        Target y;
+        generator.generate(10000, X, y);
+        y.brief_print("\nTarget: 1 = positive, 0 = negative");
+        std::cout << "\nFraction of class 1: " << arma::mean(y) << std::endl;
+        std::cout << "\nTrue weights: " << generator.get_weights();
+        DerivativeSolver solver(DiffLoss::LOG_LIKELIHOOD_LOSS_NEWTON, 1e-1, 100, 1e-3, false);
+        LogRegModel lr_model(solver);
+        lr_model.fit(X, y);
+        std::cout << "\nLearned weights: " << lr_model.get_weights();
+    }
+
+    // Time Series: stationary AR(p), p = number of features
+    {
+        DataGenerator generator(num_features, seed, Link::IDENTITY, 10.0 /* persistence */);
+        TimeSeries process = generator.generate_process(10000);
+        process.brief_print("\nTime Series: AR(8)");
+        std::cout << "\nTrue weights: " << generator.get_process_weights();
+        YuleWalkerSolver solver;
+        AutoRegModel ar_model(solver);
+        ar_model.fit(process, num_features);
+        std::cout << "\nLearned weights: " << ar_model.get_weights();
+    }
+
+    // Stream rows larger than memory to columnar dataset file in blocks, then fit on it in one pass over blocks
+    {
+        DataGenerator generator(num_features, seed, Link::IDENTITY, 1e2 /* condition number */);
+        std::cout << "\nWriting " << num_rows << " rows to columnar dataset" << std::endl;
+        try
+        {
+            generator.write("./data/synthetic.ezml", num_rows);
+        }
+        catch(DataFileException& e)
+        {
+            std::cerr << e.what();
+            return EXIT_FAILURE;
+        }
+        ColumnarDataset dataset("./data/synthetic.ezml");
+        BlockSource source(dataset, 1 << 16 /* block rows */);
+        OLSSolver solver;
+        LinRegModel lr_model(solver);
+        lr_model.fit(source);
+        std::cout << "\nTrue weights: " << generator.get_weights();
+        std::cout << "\nWeights fitted on streamed dataset: " << lr_model.get_weights();
+        // The same rows can also be streamed from generator directly, without any file
+        BlockSource generated(num_rows, num_features, 1 << 16 /* block rows */, generator.as_generator());
+        lr_model.fit(generated);
+        std::cout << "\nWeights fitted on generated blocks: " << lr_model.get_weights();
+    }
+
+    return EXIT_SUCCESS;
+}
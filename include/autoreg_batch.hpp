@@ -0,0 +1,128 @@
+/**
+ * @file autoreg_batch.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief AutoRegBatch class declarations
+ * @version 0.1
+ * @date 2024-05-06
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef AUTOREG_BATCH_HPP
+#define AUTOREG_BATCH_HPP
+
+#include <vector>
+#include "types.hpp"
+
+using namespace Types;
+
+/**
+ * @brief Batched fitting of many Autoregressive AR(p) models, one per time series.
+ * 
+ * Every series is fitted with Ordinary Least Squares, i.e. results are the same as 
+ * `AutoRegExtractor` + `AutoRegModel` + `OLSSolver`, but without building lag matrices 
+ * and without LAPACK calls: lag Gram matrix is accumulated directly from series 
+ * and solved with small-matrix Cholesky kernel. Series are fitted in parallel (OpenMP).
+ */
+class AutoRegBatch
+{
+    public:
+
+        /**
+         * @brief Construct a new AutoRegBatch object of order p.
+         * 
+         * @param p Order of lag
+         */
+        AutoRegBatch(const size_t p);
+
+        /**
+         * @brief Fit AR(p) models for series of equal length.
+         * 
+         * @param processes Matrix of time series, one series per column
+         * @return AutoRegBatch&
+         */
+        AutoRegBatch& fit(const Features& processes);
+
+        /**
+         * @brief Fit AR(p) models for series of different lengths.
+         * 
+         * @param processes Collection of time series
+         * @return AutoRegBatch&
+         */
+        AutoRegBatch& fit(const std::vector<TimeSeries>& processes);
+
+        /**
+         * @brief Get models' weights, one row (intercept first) per series.
+         * 
+         * Weights of series with singular lag matrix are NaN.
+         * 
+         * @return const BatchWeights& 
+         */
+        const BatchWeights& get_weights() const;
+
+        /**
+         * @brief Get models' sigmas (standard deviations), one per series.
+         * 
+         * @return const Sigmas& 
+         */
+        const Sigmas& get_sigmas() const;
+
+        /**
+         * @brief Check if models are fitted.
+         * 
+         * @return true 
+         * @return false 
+         */
+        const bool is_fitted() const;
+
+        /**
+         * @brief Get batch's name.
+         * 
+         * @return std::string 
+         */
+        const std::string get_name() const;
+
+    private:
+
+        /**
+         * @brief Fit AR(p) model for one series.
+         * 
+         * @param process Pointer to series values
+         * @param n Length of series
+         * @param series Index of series (row of weights)
+         * @param gram Scratch memory for (p + 1) x (p + 2) augmented Gram matrix
+         */
+        void fit_series_(const double* process, const size_t n, const size_t series, std::vector<double>& gram);
+
+        /**
+         * Order of lag.
+        */
+        size_t p_;
+
+        /**
+         * @brief Models' weights, one row per series.
+         * 
+         */
+        BatchWeights weights_;
+
+        /**
+         * @brief Models' sigmas, one per series.
+         * 
+         */
+        Sigmas sigmas_;
+
+        /**
+         * Models are fitted flag.
+        */
+        bool fitted_;
+
+        /**
+         * @brief Batch's name (string).
+         * 
+         */
+        std::string name_;
+        
+};
+
+#endif
@@ -33,6 +33,8 @@ class AutoRegExtractor
         /**
          * @brief Extract feature variables: \f$ \{ X_{t-i} \}, i = 1 \ldots p \f$.
          * 
+         * Lag matrix is built in a single pass over preallocated memory.
+         * 
          * @param process Time series vector
          * @return const Features 
          */
@@ -41,6 +43,9 @@ class AutoRegExtractor
         /**
          * @brief Extract target variable: \f$ y_{t} \f$.
          * 
+         * Returned target is a view over `process` memory (no copy is made), 
+         * so `process` must outlive it and must not be resized meanwhile.
+         * 
          * @param process Time series vector
          * @return const Target 
          */
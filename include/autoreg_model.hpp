@@ -12,6 +12,7 @@
 #ifndef AUTOREG_MODEL_HPP
 #define AUTOREG_MODEL_HPP
 
+#include <boost/random/mersenne_twister.hpp>
 #include "types.hpp"
 #include "base_model.hpp"
 
@@ -20,7 +21,7 @@ using namespace Types;
 /**
  * @brief Autoregressive AR(p) model class template. Inherits from `BaseModel` class.
  * 
- * @tparam SolverType class of solver: `BaseSolver`, `OLSSolver`, `QRSolver`, `DerivativeSolver`
+ * @tparam SolverType class of solver: `BaseSolver`, `OLSSolver`, `QRSolver`, `DerivativeSolver`, `TypedDerivativeSolver`, `RidgeSolver`, `ElasticNetSolver`, `YuleWalkerSolver`
  */
 template <typename SolverType>
 class AutoRegModel : public BaseModel
@@ -38,9 +39,16 @@ class AutoRegModel : public BaseModel
         /**
          * @brief Get model's weights.
          * 
-         * @return const Weights 
+         * @return const Weights& 
          */
-        const Weights get_weights() const;
+        const Weights& get_weights() const;
+
+        /**
+         * @brief Get solver the model is fitted with, i.e. to inspect solver's results.
+         * 
+         * @return const SolverType& 
+         */
+        const SolverType& get_solver() const;
 
         /**
          * @brief Get model's sigma (standard deviation).
@@ -61,20 +69,114 @@ class AutoRegModel : public BaseModel
          * 
          * @param X Matrix of feature variables extracted with `AutoRegExtractor`
          * @param y Column vector of target variable extracted with `AutoRegExtractor`
-         * @return AutoRegModel
+         * @return AutoRegModel&
          */
-        const AutoRegModel fit(Features& X, const Target& y);
+        AutoRegModel& fit(Features& X, const Target& y);
+
+        /**
+         * @brief Fit AR(p) model directly on time series, i.e. without lag matrix.
+         * 
+         * Available with `YuleWalkerSolver` only.
+         * 
+         * @param process Time series vector
+         * @param p Order of lag
+         * @return AutoRegModel&
+         */
+        AutoRegModel& fit(const TimeSeries& process, const size_t p);
+
+        /**
+         * @brief Fit AR(p) model of best order \f$ p \le p_{max} \f$ directly on time series.
+         * 
+         * All orders are fitted and scored in one sweep. Available with `YuleWalkerSolver` only.
+         * 
+         * @param process Time series vector
+         * @param max_p Max order of lag
+         * @param criterion Information criterion to minimize
+         * @return const InfoCriteria AIC and BIC of every order \f$ 1 \ldots p_{max} \f$
+         */
+        const InfoCriteria select_order(const TimeSeries& process, const size_t max_p, const Criterion criterion=Criterion::AIC);
 
         /**
          * @brief Predict future values of time series with fitted model.
          * 
+         * White noise is randomized on every method call.
+         * Throws `LagsShapeException`, if `X` does not have intercept feature and p lag features.
+         * 
          * @param X Matrix of feature variables extracted with `AutoRegExtractor`
          * @param num_periods Number of forecast periods
          * @return const TimeSeries
          */
         const TimeSeries predict(const Features& X, const size_t num_periods) const;
 
+        /**
+         * @brief Predict future values of time series with fitted model using explicitly seeded noise.
+         * 
+         * Features are rolled in a fixed-size circular buffer of p latest values, 
+         * so forecasting takes linear time in the number of periods.
+         * Throws `LagsShapeException`, if `X` does not have intercept feature and p lag features.
+         * 
+         * @param X Matrix of feature variables extracted with `AutoRegExtractor`
+         * @param num_periods Number of forecast periods
+         * @param seed Seed of white noise random number generator
+         * @return const TimeSeries
+         */
+        const TimeSeries predict(const Features& X, const size_t num_periods, const unsigned int seed) const;
+
+        /**
+         * @brief Predict future values of time series with fitted model using explicitly seeded noise into output buffer, which is resized only if needed.
+         * 
+         * @param X Matrix of feature variables extracted with `AutoRegExtractor`
+         * @param num_periods Number of forecast periods
+         * @param seed Seed of white noise random number generator
+         * @param out Output forecast
+         */
+        void predict_into(const Features& X, const size_t num_periods, const unsigned int seed, TimeSeries& out) const;
+
+        /**
+         * @brief Predict future values of time series, following its last p values, with fitted model using explicitly seeded noise.
+         * 
+         * Lag features are taken from the tail of time series, so models fitted directly on time series 
+         * (i.e. with `YuleWalkerSolver`) need no lag matrix. Throws `WrongOrderException`, if time series is shorter than p.
+         * 
+         * @param process Time series vector
+         * @param num_periods Number of forecast periods
+         * @param seed Seed of white noise random number generator
+         * @return const TimeSeries
+         */
+        const TimeSeries forecast(const TimeSeries& process, const size_t num_periods, const unsigned int seed) const;
+
+        /**
+         * @brief Simulate many future paths of time series with fitted model (Monte Carlo).
+         * 
+         * Paths are simulated in parallel (OpenMP). Every path has its own random number stream 
+         * derived from `seed` and path's index, so results do not depend on number of threads.
+         * Throws `LagsShapeException`, if `X` does not have intercept feature and p lag features,
+         * and `WrongPathsException`, if number of periods or number of paths is zero.
+         * 
+         * @param X Matrix of feature variables extracted with `AutoRegExtractor`
+         * @param num_periods Number of forecast periods
+         * @param num_paths Number of simulated paths
+         * @param seed Seed of white noise random number generators
+         * @param levels Quantile levels of prediction bands, in [0, 1]
+         * @return const ForecastBands Mean path and matrix of quantile bands (one column per level)
+         */
+        const ForecastBands simulate(const Features& X, 
+                                     const size_t num_periods, 
+                                     const size_t num_paths, 
+                                     const unsigned int seed, 
+                                     const QuantileLevels& levels={0.05, 0.5, 0.95}) const;
+
     private:
+
+        /**
+         * @brief Simulate one future path of time series into preallocated memory.
+         * 
+         * @param X Matrix of feature variables extracted with `AutoRegExtractor`
+         * @param num_periods Number of forecast periods
+         * @param rng Random number generator of white noise
+         * @param forecast Pointer to memory for `num_periods` forecasted values
+         */
+        void simulate_path_(const Features& X, const size_t num_periods, boost::mt19937& rng, double* forecast) const;
         
         /**
          * @brief Row vector of model's weights.
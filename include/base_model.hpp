@@ -13,6 +13,7 @@
 #define BASE_MODEL_HPP
 
 #include "types.hpp"
+#include "stats.hpp"
 
 using namespace Types;
 
@@ -39,9 +40,9 @@ class BaseModel
         /**
          * @brief Fit model.
          * 
-         * @return BaseModel
+         * @return BaseModel&
          */
-        const BaseModel fit(const Features& X, const Target& y);
+        BaseModel& fit(const Features& X, const Target& y);
 
         /**
          * @brief Predict target variable with fitted model.
@@ -50,6 +51,14 @@ class BaseModel
          * @return const Target 
          */
         const Target predict(const Features& X) const;
+
+        /**
+         * @brief Predict target variable with fitted model into output buffer, which is resized only if needed.
+         * 
+         * @param X Matrix of feature variables
+         * @param out Output column vector of target variable
+         */
+        void predict_into(const Features& X, Target& out) const;
         
         /**
          * @brief Check if model is fitted.
@@ -66,8 +75,54 @@ class BaseModel
          */
         const std::string get_name() const;
 
+        /**
+         * @brief Get instrumentation stats of model's phases, empty unless library is built with `EZML_STATS` defined.
+         * 
+         * Stats are recorded by non-const methods (fit) only, so const methods (predict) may be called from many threads at once
+         * and are recorded to trace only. Stats must not be read while the model is being fitted.
+         * 
+         * @return const Stats& 
+         */
+        const Stats& get_stats() const;
+
+        /**
+         * @brief Set warm start: next fits begin optimization from current weights of fitted model, if their shape matches.
+         * 
+         * Used by models learning weights iteratively: `LinRegModel`, `LogRegModel`, `SoftmaxRegModel`, `AutoRegModel`.
+         * 
+         * @param warm_start Warm start flag
+         */
+        void set_warm_start(const bool warm_start);
+
+        /**
+         * @brief Set weights to begin optimization of the next fit from, i.e. weights of yesterday's model.
+         * 
+         * Weights are used once, intercept weight first. `SoftmaxRegModel` takes weights of all classes flattened column by column.
+         * 
+         * @param w Row vector of initial weights
+         */
+        void set_initial_weights(const Weights& w);
+
+        /**
+         * @brief Set seed of random number generator for cold starts, so initial weights are reproducible.
+         * 
+         * @param seed Seed of Gaussian noise of initial weights
+         */
+        void set_seed(const unsigned int seed);
+
     protected:
 
+        /**
+         * @brief Return weights to begin optimization from.
+         * 
+         * Given initial weights first, then current weights if warm start is set, otherwise Gaussian noise N(0, 1), seeded if seed is set.
+         * 
+         * @param current Row vector of current weights
+         * @param num_weights Number of weights, intercept included
+         * @return const Weights 
+         */
+        const Weights init_weights_(const Weights& current, const size_t num_weights);
+
         /**
          * @brief Mark model as fitted.
          * 
@@ -80,6 +135,12 @@ class BaseModel
          */
         std::string name_;
 
+        /**
+         * @brief Instrumentation stats, recorded by non-const methods only.
+         * 
+         */
+        Stats stats_;
+
     private:
 
         /**
@@ -92,6 +153,30 @@ class BaseModel
          * 
          */
         Target y_mean_;
+
+        /**
+         * @brief Warm start flag.
+         * 
+         */
+        bool warm_start_;
+
+        /**
+         * @brief Weights to begin optimization of the next fit from.
+         * 
+         */
+        Weights initial_weights_;
+
+        /**
+         * @brief Random number generator is seeded flag.
+         * 
+         */
+        bool seeded_;
+
+        /**
+         * @brief Seed of random number generator for cold starts.
+         * 
+         */
+        unsigned int seed_;
         
 };
 
@@ -14,6 +14,7 @@
 
 #include <functional>
 #include "types.hpp"
+#include "stats.hpp"
 
 using namespace Types;
 
@@ -55,6 +56,15 @@ class BaseSolver
          */
         const std::string get_name() const;
 
+        /**
+         * @brief Get instrumentation stats of solver's phases, empty unless library is built with `EZML_STATS` defined.
+         * 
+         * Stats are recorded by non-const methods (optimize) only, so stats must not be read while the solver is optimizing.
+         * 
+         * @return const Stats& 
+         */
+        const Stats& get_stats() const;
+
     protected:
 
         /**
@@ -63,6 +73,12 @@ class BaseSolver
          */
         std::string name_;
 
+        /**
+         * @brief Instrumentation stats, recorded by non-const methods only.
+         * 
+         */
+        Stats stats_;
+
         /**
          * @brief Show solver's steps flag.
          * 
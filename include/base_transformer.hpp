@@ -13,6 +13,7 @@
 #define BASE_TRANSFORMER_HPP
 
 #include "types.hpp"
+#include "stats.hpp"
 
 using namespace Types;
 
@@ -39,9 +40,9 @@ class BaseTransformer
         /**
          * @brief Fit transformer.
          * 
-         * @return BaseTransformer
+         * @return BaseTransformer&
          */
-        BaseTransformer fit(Features& X);
+        BaseTransformer& fit(Features& X);
 
         /**
          * @brief Transform feature variables with fitted model.
@@ -51,6 +52,14 @@ class BaseTransformer
          */
         const Features transform(Features& X);
 
+        /**
+         * @brief Transform feature variables with fitted transformer into output buffer, which is resized only if needed.
+         * 
+         * @param X Matrix of feature variables
+         * @param out Output matrix of transformed features
+         */
+        void transform_into(const Features& X, Features& out) const;
+
         /**
          * @brief Fit transformer, then transform feature variables.
          * 
@@ -58,6 +67,16 @@ class BaseTransformer
          * @return const Features 
          */
         const Features fit_transform(Features& X);
+
+        /**
+         * @brief Fold transformation into weights of linear model fitted on transformed features.
+         * 
+         * BaseTransformer is the identity, so weights are returned unchanged.
+         * 
+         * @param W Matrix of weights, intercept in the first row, one column per output
+         * @return const ClassWeights 
+         */
+        const ClassWeights fold(const ClassWeights& W) const;
         
         /**
          * @brief Check if transformer is fitted.
@@ -74,6 +93,16 @@ class BaseTransformer
          */
         const std::string get_name() const;
 
+        /**
+         * @brief Get instrumentation stats of transformer's phases, empty unless library is built with `EZML_STATS` defined.
+         * 
+         * Stats are recorded by non-const methods (fit, transform) only, so const methods (transform_into) may be called from many threads at once
+         * and are recorded to trace only. Stats must not be read while the transformer is being fitted.
+         * 
+         * @return const Stats& 
+         */
+        const Stats& get_stats() const;
+
     protected:
 
         /**
@@ -88,6 +117,12 @@ class BaseTransformer
          */
         std::string name_;
 
+        /**
+         * @brief Instrumentation stats, recorded by non-const methods only.
+         * 
+         */
+        Stats stats_;
+
     private:
 
         /**
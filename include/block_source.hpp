@@ -0,0 +1,145 @@
+/**
+ * @file block_source.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief BlockSource class declarations
+ * @version 0.1
+ * @date 2024-05-29
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef BLOCK_SOURCE_HPP
+#define BLOCK_SOURCE_HPP
+
+#include <functional>
+#include "types.hpp"
+#include "columnar_dataset.hpp"
+
+using namespace Types;
+
+/**
+ * @brief Source of data streamed in fixed-size blocks of rows, for fitting on data larger than memory.
+ * 
+ * Blocks are produced on demand either by generator function, or from columnar dataset file, 
+ * so at most one block is held in memory at a time. Solvers that support it make one pass over blocks per fit 
+ * (sufficient statistics) or per iteration (summed gradients).
+ */
+class BlockSource
+{
+    public:
+
+        /**
+         * @brief Generator of block: fill given rows of features (matrix of block's rows by number of features, without intercept feature) and target.
+         * 
+         * Must produce the same rows every time it is called with the same first row.
+         */
+        using Generator = std::function<void(const size_t first_row, Features& X, Target& y)>;
+
+        /**
+         * @brief Construct a new BlockSource object from generator.
+         * 
+         * @param num_rows Total number of rows
+         * @param num_features Number of features
+         * @param block_rows Number of rows in block (the last block may be shorter)
+         * @param generator Generator of block
+         */
+        BlockSource(const size_t num_rows, const size_t num_features, const size_t block_rows, const Generator& generator);
+
+        /**
+         * @brief Construct a new BlockSource object that reads rows of columnar dataset file. Columns must be uncompressed.
+         * 
+         * @param dataset Columnar dataset
+         * @param block_rows Number of rows in block (the last block may be shorter)
+         */
+        BlockSource(const ColumnarDataset& dataset, const size_t block_rows);
+
+        /**
+         * @brief Read block of rows.
+         * 
+         * Buffers are resized only if block size changes, so they can be reused across blocks. Throws `WrongBlockException`, if block is out of range.
+         * 
+         * @param block Index of block
+         * @param X Output matrix of feature variables, first column is intercept (dummy) feature, as added by models
+         * @param y Output column vector of target variable
+         */
+        void read(const size_t block, Features& X, Target& y) const;
+
+        /**
+         * @brief Accumulate means and centered scatter (co-moment) matrix of features and target in one pass over blocks.
+         * 
+         * Blocks are merged pairwise (Chan et al.), which avoids cancellation of the naive \f$ X^T X - n \bar{x} \bar{x}^T \f$:
+         * 
+         * \f$ \displaystyle C = C_{a} + C_{b} + \frac{n_{a} n_{b}}{n_{a} + n_{b}} \delta \delta^T, \quad \delta = \bar{z}_{b} - \bar{z}_{a} \f$,
+         * where \f$ z = (x_{1}, \ldots, x_{d}, y) \f$.
+         * 
+         * These are sufficient statistics for Ordinary Least Squares and ridge with intercept.
+         * 
+         * @param means Output column vector of means of features, then of target
+         * @param scatter Output centered scatter matrix of features, then of target
+         */
+        void accumulate(Target& means, Features& scatter) const;
+
+        /**
+         * @brief Get total number of rows.
+         * 
+         * @return size_t 
+         */
+        size_t get_num_rows() const;
+
+        /**
+         * @brief Get number of features (without intercept feature).
+         * 
+         * @return size_t 
+         */
+        size_t get_num_features() const;
+
+        /**
+         * @brief Get number of blocks.
+         * 
+         * @return size_t 
+         */
+        size_t get_num_blocks() const;
+
+        /**
+         * @brief Get source's name.
+         * 
+         * @return std::string 
+         */
+        const std::string get_name() const;
+
+    private:
+
+        /**
+         * @brief Total number of rows.
+         * 
+         */
+        size_t num_rows_;
+
+        /**
+         * @brief Number of features.
+         * 
+         */
+        size_t num_features_;
+
+        /**
+         * @brief Number of rows in block.
+         * 
+         */
+        size_t block_rows_;
+
+        /**
+         * @brief Generator of block.
+         * 
+         */
+        Generator generator_;
+
+        /**
+         * @brief Source's name (string).
+         * 
+         */
+        std::string name_;
+
+};
+
+#endif
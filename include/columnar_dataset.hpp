@@ -0,0 +1,197 @@
+/**
+ * @file columnar_dataset.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief ColumnarDataset class declarations
+ * @version 0.1
+ * @date 2024-05-27
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef COLUMNAR_DATASET_HPP
+#define COLUMNAR_DATASET_HPP
+
+#include <memory>
+#include <vector>
+#include "types.hpp"
+#include "mapped_file.hpp"
+#include "csv_loader.hpp"
+
+using namespace Types;
+
+class BlockSource;
+
+/**
+ * @brief Binary columnar dataset file: features and target cached on disk, loaded without parsing.
+ * 
+ * File holds a schema header (name, storage type and compression of every column), 
+ * then feature columns and target column, each stored contiguously. 
+ * Data starts at a page boundary, so uncompressed `ColumnType::FLOAT64` columns are handed out as matrices 
+ * that view the memory-mapped file in place: loading costs only page faults on first access. 
+ * Other columns are decoded in parallel (OpenMP) into memory.
+ */
+class ColumnarDataset
+{
+    public:
+
+        /**
+         * @brief Open columnar dataset file. Throws `DataFileException`, if file cannot be read or is not a valid dataset.
+         * 
+         * @param path Path to dataset file
+         */
+        ColumnarDataset(const std::string& path);
+
+        /**
+         * @brief Write features and target to columnar dataset file. Throws `DataFileException`, if file cannot be written.
+         * 
+         * @param path Path to dataset file
+         * @param X Matrix of feature variables
+         * @param y Column vector of target variable
+         * @param schema Schema of every feature column, then of target column. Empty means unnamed uncompressed `ColumnType::FLOAT64` columns
+         */
+        static void write(const std::string& path, const Features& X, const Target& y, const std::vector<ColumnSchema>& schema={});
+
+        /**
+         * @brief Convert CSV file to columnar dataset file.
+         * 
+         * @param csv_path Path to CSV file
+         * @param loader Loader with selected feature and target columns of CSV file
+         * @param path Path to dataset file
+         * @param schema Schema of every feature column, then of target column. Empty means unnamed uncompressed `ColumnType::FLOAT64` columns
+         */
+        static void convert(const std::string& csv_path, const CSVLoader& loader, const std::string& path, const std::vector<ColumnSchema>& schema={});
+
+        /**
+         * @brief Write data streamed in blocks to columnar dataset file of unnamed uncompressed `ColumnType::FLOAT64` columns, 
+         * i.e. data larger than memory. Throws `DataFileException`, if file cannot be written.
+         * 
+         * Every block is written into its rows of every column, so at most one block is held in memory at a time.
+         * 
+         * @param path Path to dataset file
+         * @param source Source of blocks of data
+         */
+        static void write(const std::string& path, const BlockSource& source);
+
+        /**
+         * @brief Get matrix of feature variables.
+         * 
+         * If all feature columns are uncompressed `ColumnType::FLOAT64`, matrix views the mapped file without copying. 
+         * Such view stays valid while this dataset (or its copy) exists. Writes to it are copy-on-write and never reach the file, 
+         * and resizing it (e.g. adding dummy feature in `fit()`) moves it to its own memory.
+         * 
+         * @return const Features 
+         */
+        const Features get_features() const;
+
+        /**
+         * @brief Get column vector of target variable. Views the mapped file, if target column is uncompressed `ColumnType::FLOAT64`.
+         * 
+         * @return const Target 
+         */
+        const Target get_target() const;
+
+        /**
+         * @brief Read block of rows of features and target, e.g. to stream dataset larger than memory.
+         * 
+         * Only requested rows are read from file (not through the mapping), so memory use is bounded by block size. 
+         * Throws `DataFileException`, if some column is compressed or cannot be read.
+         * 
+         * @param first_row Index of first row to read
+         * @param X Output matrix of feature variables, already sized to number of rows to read by number of features
+         * @param y Output column vector of target variable, already sized to number of rows to read
+         */
+        void read_rows(const size_t first_row, Features& X, Target& y) const;
+
+        /**
+         * @brief Get schema of every feature column, then of target column.
+         * 
+         * @return const std::vector<ColumnSchema> 
+         */
+        const std::vector<ColumnSchema> get_schema() const;
+
+        /**
+         * @brief Get number of rows (observations).
+         * 
+         * @return size_t 
+         */
+        size_t get_num_rows() const;
+
+        /**
+         * @brief Get number of feature columns.
+         * 
+         * @return size_t 
+         */
+        size_t get_num_features() const;
+
+        /**
+         * @brief Get dataset's name.
+         * 
+         * @return std::string 
+         */
+        const std::string get_name() const;
+
+    private:
+
+        /**
+         * @brief Check if column is stored as raw doubles, so it can be viewed in place.
+         * 
+         * @param col Index of column
+         * @return true 
+         * @return false 
+         */
+        bool is_raw_(const size_t col) const;
+
+        /**
+         * @brief Decode column into doubles.
+         * 
+         * @param col Index of column
+         * @param out Output buffer of number of rows doubles
+         */
+        void decode_(const size_t col, double* out) const;
+
+        /**
+         * @brief Memory-mapped dataset file, shared by copies of dataset.
+         * 
+         */
+        std::shared_ptr<MappedFile> file_;
+
+        /**
+         * @brief Path to dataset file.
+         * 
+         */
+        std::string path_;
+
+        /**
+         * @brief Number of rows.
+         * 
+         */
+        size_t num_rows_;
+
+        /**
+         * @brief Schema of every feature column, then of target column.
+         * 
+         */
+        std::vector<ColumnSchema> schema_;
+
+        /**
+         * @brief Byte offset of every column's data in file.
+         * 
+         */
+        std::vector<size_t> offsets_;
+
+        /**
+         * @brief Byte size of every column's data in file.
+         * 
+         */
+        std::vector<size_t> sizes_;
+
+        /**
+         * @brief Dataset's name (string).
+         * 
+         */
+        std::string name_;
+
+};
+
+#endif
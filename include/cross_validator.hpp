@@ -0,0 +1,91 @@
+/**
+ * @file cross_validator.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief CrossValidator class declarations
+ * @version 0.1
+ * @date 2024-05-08
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef CROSS_VALIDATOR_HPP
+#define CROSS_VALIDATOR_HPP
+
+#include "types.hpp"
+
+using namespace Types;
+
+/**
+ * @brief K-fold cross-validation of linear regression (Ordinary Least Squares or ridge).
+ * 
+ * Gram matrix \f$ X^T X \f$ and \f$ X^T y \f$ of full data are computed once. 
+ * Training Gram matrix of every fold is obtained by subtracting (downdating) that fold's contribution, 
+ * so every fold costs \f$ O(d^3) \f$ on top of a single \f$ O(n d^2) \f$ pass over data. 
+ * Folds are evaluated in parallel (OpenMP).
+ */
+class CrossValidator
+{
+    public:
+
+        /**
+         * @brief Construct a new CrossValidator object.
+         * 
+         * @param num_folds Number of folds (k)
+         * @param lambda L2 regularization strength, 0 means Ordinary Least Squares
+         */
+        CrossValidator(const size_t num_folds, const double lambda=0.0);
+
+        /**
+         * @brief Evaluate linear regression with intercept on every fold.
+         * 
+         * Folds are contiguous blocks of rows. For every fold, model is fitted on the other folds 
+         * by minimizing \f$ \| y - X w \|^2 + \lambda \| w_{1 \ldots d} \|^2 \f$ (intercept is not penalized), 
+         * then scored on the fold with `Metrics::mse` and `Metrics::r2`. Scores of folds with singular training system are NaN.
+         * 
+         * @param X Matrix of feature variables (without intercept feature)
+         * @param y Column vector of target variable
+         * @return const CVScores 
+         */
+        const CVScores evaluate(const Features& X, const Target& y) const;
+
+        /**
+         * @brief Get cross-validator's name.
+         * 
+         * @return std::string 
+         */
+        const std::string get_name() const;
+
+    private:
+
+        /**
+         * @brief Compute augmented Gram matrix \f$ [1, X]^T [1, X] \f$ and vector \f$ [1, X]^T y \f$ without materializing intercept feature.
+         * 
+         * @param X Matrix of feature variables
+         * @param y Column vector of target variable
+         * @param gram Output Gram matrix
+         * @param moment Output \f$ [1, X]^T y \f$ vector
+         */
+        static void gram_(const Features& X, const Target& y, Features& gram, Target& moment);
+
+        /**
+         * @brief Number of folds.
+         * 
+         */
+        size_t num_folds_;
+
+        /**
+         * @brief L2 regularization strength.
+         * 
+         */
+        double lambda_;
+
+        /**
+         * @brief Cross-validator's name (string).
+         * 
+         */
+        std::string name_;
+        
+};
+
+#endif
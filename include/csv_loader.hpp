@@ -0,0 +1,127 @@
+/**
+ * @file csv_loader.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief CSVLoader class declarations
+ * @version 0.1
+ * @date 2024-05-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef CSV_LOADER_HPP
+#define CSV_LOADER_HPP
+
+#include <vector>
+#include "types.hpp"
+
+using namespace Types;
+
+/**
+ * @brief Multithreaded loader of numeric CSV files into features and target.
+ * 
+ * File is memory-mapped and split into line-aligned chunks, which are parsed in parallel (OpenMP).
+ * Only selected columns are parsed, straight into column-major features matrix and target vector,
+ * so the full table is never allocated.
+ */
+class CSVLoader
+{
+    public:
+
+        /**
+         * @brief Construct a new CSVLoader object.
+         * 
+         * @param feature_cols Indices (0-based) of columns to load as features, in the order of features
+         * @param target_col Index (0-based) of column to load as target
+         * @param header_rows Number of leading rows to skip (header)
+         * @param delimiter Field delimiter
+         */
+        CSVLoader(const std::vector<size_t>& feature_cols, const size_t target_col, const size_t header_rows=1, const char delimiter=',');
+
+        /**
+         * @brief Load selected columns of CSV file.
+         * 
+         * Empty rows are skipped, empty fields are loaded as NaN.
+         * Throws `DataFileException`, if file cannot be read, or some row is too short or has a non-numeric selected field.
+         * 
+         * @param path Path to CSV file
+         * @param X Output matrix of feature variables, one column per selected feature column
+         * @param y Output column vector of target variable
+         */
+        void load(const std::string& path, Features& X, Target& y) const;
+
+        /**
+         * @brief Get loader's name.
+         * 
+         * @return std::string 
+         */
+        const std::string get_name() const;
+
+    private:
+
+        /**
+         * @brief Count non-empty rows in chunk.
+         * 
+         * @param begin Start of chunk (start of line)
+         * @param end End of chunk (start of line or end of file)
+         * @return size_t 
+         */
+        static size_t count_rows_(const char* begin, const char* end);
+
+        /**
+         * @brief Parse selected fields of non-empty rows in chunk.
+         * 
+         * @param begin Start of chunk (start of line)
+         * @param end End of chunk (start of line or end of file)
+         * @param row Index of chunk's first row in output
+         * @param X Output matrix of feature variables
+         * @param y Output column vector of target variable
+         * @return size_t Number of rows parsed, less than number of rows in chunk, if some row is malformed
+         */
+        size_t parse_rows_(const char* begin, const char* end, size_t row, Features& X, Target& y) const;
+
+        /**
+         * @brief Indices of feature columns.
+         * 
+         */
+        std::vector<size_t> feature_cols_;
+
+        /**
+         * @brief Index of target column.
+         * 
+         */
+        size_t target_col_;
+
+        /**
+         * @brief Number of header rows to skip.
+         * 
+         */
+        size_t header_rows_;
+
+        /**
+         * @brief Field delimiter.
+         * 
+         */
+        char delimiter_;
+
+        /**
+         * @brief Output slot of every column up to the last selected one: feature index, number of features for target, -1 if skipped.
+         * 
+         */
+        std::vector<long> slots_;
+
+        /**
+         * @brief Pairs of (output slot, source slot) for columns selected more than once.
+         * 
+         */
+        std::vector<std::pair<size_t, size_t>> copies_;
+
+        /**
+         * @brief Loader's name (string).
+         * 
+         */
+        std::string name_;
+
+};
+
+#endif
@@ -0,0 +1,179 @@
+/**
+ * @file data_generator.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief DataGenerator class declarations
+ * @version 0.1
+ * @date 2024-06-03
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef DATA_GENERATOR_HPP
+#define DATA_GENERATOR_HPP
+
+#include "types.hpp"
+#include "block_source.hpp"
+
+using namespace Types;
+
+/**
+ * @brief Seeded generator of synthetic linear, logistic and autoregressive data of any size, with known true weights.
+ * 
+ * Features are correlated Gaussian \f$ x = z M \f$, where \f$ z \sim N(0, I) \f$ and mixing matrix \f$ M = \mathrm{diag}(s) Q^T \f$
+ * with random rotation \f$ Q \f$ and scales \f$ s_{j} = \kappa^{-j / 2(d-1)} \f$, so condition number of \f$ X^T X \f$ tends to \f$ \kappa \f$.
+ * 
+ * Every row is drawn from its own counter-based random stream, keyed by seed and row index, so any block of rows
+ * can be generated independently, in parallel, and the data do not depend on block size nor number of threads.
+ */
+class DataGenerator
+{
+    public:
+
+        /**
+         * @brief Construct a new DataGenerator object.
+         * 
+         * @param num_features Number of features (and order of autoregressive process)
+         * @param seed Seed of random streams
+         * @param link Link between linear predictor and target
+         * @param condition_number Condition number of \f$ X^T X \f$ (and persistence of autoregressive process), `1` for independent features
+         * @param sparsity Fraction of true weights (without intercept) set to zero
+         * @param noise Standard deviation of Gaussian noise of target (identity link) and of innovations of autoregressive process
+         * @param balance Approximate fraction of class 1 (logit link)
+         */
+        DataGenerator(const size_t num_features, const unsigned int seed, const Link link=Link::IDENTITY,
+                      const double condition_number=1.0, const double sparsity=0.0, const double noise=1.0, const double balance=0.5);
+
+        /**
+         * @brief Fill given rows of features and target in place, in parallel.
+         * 
+         * Follows `BlockSource::Generator` contract: buffers are already sized, features are without intercept feature.
+         * 
+         * @param first_row Index of first row
+         * @param X Matrix of rows by number of features
+         * @param y Column vector of rows
+         */
+        void fill(const size_t first_row, Features& X, Target& y) const;
+
+        /**
+         * @brief Generate rows in memory, in parallel.
+         * 
+         * @param num_rows Number of rows
+         * @param X Output matrix of feature variables (without intercept feature)
+         * @param y Output column vector of target variable
+         */
+        void generate(const size_t num_rows, Features& X, Target& y) const;
+
+        /**
+         * @brief Get generator of blocks, e.g. to stream data larger than memory to models with `BlockSource`.
+         * 
+         * The generator copies the data generator, so it may outlive it.
+         * 
+         * @return BlockSource::Generator
+         */
+        BlockSource::Generator as_generator() const;
+
+        /**
+         * @brief Stream rows to columnar dataset file in blocks, so data larger than memory can be written.
+         * Throws `DataFileException`, if file cannot be written.
+         * 
+         * @param path Path to dataset file
+         * @param num_rows Number of rows
+         * @param block_rows Number of rows in block
+         */
+        void write(const std::string& path, const size_t num_rows, const size_t block_rows=1 << 16) const;
+
+        /**
+         * @brief Generate stationary autoregressive process AR(p) of order p = number of features:
+         * 
+         * \f$ x_{t} = c + \phi_{1} x_{t-1} + \ldots + \phi_{p} x_{t-p} + \varepsilon_{t}, \quad \varepsilon_{t} \sim N(0, \sigma^2) \f$.
+         * 
+         * Coefficients are drawn as partial autocorrelations \f$ \alpha_{k} \sim U(-r, r) \f$, \f$ r = 1 - 1 / (1 + \kappa) \f$,
+         * which are then converted to \f$ \phi \f$ by Levinson-Durbin recursion, so the process is stationary for any order.
+         * Sparsity sets partial autocorrelations to zero. The first periods are discarded as burn-in.
+         * 
+         * @param length Number of periods
+         * @return TimeSeries
+         */
+        TimeSeries generate_process(const size_t length) const;
+
+        /**
+         * @brief Get true weights of linear predictor (intercept first), as learned by models.
+         * 
+         * @return const Weights&
+         */
+        const Weights& get_weights() const;
+
+        /**
+         * @brief Get true weights of autoregressive process (intercept first, then \f$ \phi_{1}, \ldots, \phi_{p} \f$), as learned by `AutoRegModel`.
+         * 
+         * @return const Weights&
+         */
+        const Weights& get_process_weights() const;
+
+        /**
+         * @brief Get generator's name.
+         * 
+         * @return const std::string
+         */
+        const std::string get_name() const;
+
+    private:
+
+        /**
+         * @brief Number of rows generated by one task.
+         * 
+         */
+        static constexpr size_t CHUNK_ROWS = 4096;
+
+        /**
+         * @brief Number of features.
+         * 
+         */
+        size_t num_features_;
+
+        /**
+         * @brief Seed of random streams.
+         * 
+         */
+        unsigned int seed_;
+
+        /**
+         * @brief Link between linear predictor and target.
+         * 
+         */
+        Link link_;
+
+        /**
+         * @brief Standard deviation of noise.
+         * 
+         */
+        double noise_;
+
+        /**
+         * @brief Mixing matrix of features, empty for independent features.
+         * 
+         */
+        Features mixing_;
+
+        /**
+         * @brief True weights of linear predictor.
+         * 
+         */
+        Weights weights_;
+
+        /**
+         * @brief True weights of autoregressive process.
+         * 
+         */
+        Weights process_weights_;
+
+        /**
+         * @brief Generator's name (string).
+         * 
+         */
+        std::string name_;
+
+};
+
+#endif
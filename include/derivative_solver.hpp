@@ -14,15 +14,18 @@
 
 #include <functional>
 #include "types.hpp"
-#include "base_solver.hpp"
+#include "typed_derivative_solver.hpp"
+#include "diff_loss_functions.hpp"
 
 using namespace Types;
 
 /**
- * @brief Derivative Solver class. Inherits from `BaseSolver` class.
+ * @brief Derivative Solver class with derivative of loss function chosen at runtime. Inherits from `TypedDerivativeSolver` class.
+ * 
+ * Loss is called through `std::function`, use `TypedDerivativeSolver` with loss functor type to let compiler inline it.
  * 
  */
-class DerivativeSolver : public BaseSolver
+class DerivativeSolver : public TypedDerivativeSolver<DiffLoss::DynamicLoss>
 {
     public:
         
@@ -34,59 +37,15 @@ class DerivativeSolver : public BaseSolver
          * @param max_iter Max number of optimization iterations
          * @param min_grad_size Min size of the vector of derivative
          * @param verbose 
+         * @param parallel Reduce derivative over blocks of rows on all threads flag, for losses held by `DiffLoss` gradient aliases
          */
         DerivativeSolver(const std::function<Derivative(const Weights&, const Features&, const Target&)>& diff_loss_func,
                          const double learning_rate, 
                          const size_t max_iter, 
                          const double min_grad_size, 
-                         const bool verbose);
-        
-        /**
-         * @brief Return learned weights by using gradient descent for MSE loss function.
-         * 
-         * @param w Row vector of weights
-         * @param X Matrix of feature variables
-         * @param y Column vector of target variable
-         * @return Weights 
-         */
-        const Weights optimize(Weights& w, const Features& X, const Target& y);
-
-        /**
-         * @brief Compute derivative of loss function.
-         * 
-         * @param w Row vector of weights
-         * @param X Matrix of feature variables
-         * @param y Column vector of target variable
-         * @return Derivative
-         */
-        const Derivative compute_derivative(const Weights& w, const Features& X, const Target& y);
-
-    private:
-
-        /**
-         * @brief Derivative of loss function used for computing optimization step.
-         * 
-         */
-        const std::function<Derivative(const Weights&, const Features&, const Target&)>& diff_loss_func_;
-        
-        /**
-         * @brief Learning rate.
-         * 
-         */
-        const double learning_rate_;
-        
-        /**
-         * @brief Max number of optimization iterations.
-         * 
-         */
-        const size_t max_iter_;
-        
-        /**
-         * @brief Min size of the vector of derivative.
-         * 
-         */
-        const double min_derivative_size_;
+                         const bool verbose,
+                         const bool parallel=false);
 
 };
 
-#endif
\ No newline at end of file
+#endif
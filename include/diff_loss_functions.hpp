@@ -12,6 +12,7 @@
 #ifndef DIFF_LOSS_FUNCTIONS_HPP
 #define DIFF_LOSS_FUNCTIONS_HPP
 
+#include <cmath>
 #include <functional>
 #include <armadillo>
 #include "types.hpp"
@@ -23,6 +24,9 @@ using namespace Types;
 namespace DiffLoss
 {
 
+    // Functions are inline, not static, so they have the same address in every translation unit
+    // and `DynamicLoss` can recognize them, when passed as plain functions
+
     /**
      * @brief Gradient (first derivative) of Mean Squared Error loss.
      *
@@ -37,10 +41,10 @@ namespace DiffLoss
      * @param y_true Column vector of target variable
      * @return const Derivative 
      */
-    static const Derivative mean_squared_error_loss_grad(const Weights& w, const Features& X, const Target& y_true)
+    inline const Derivative mean_squared_error_loss_grad(const Weights& w, const Features& X, const Target& y_true)
     {
-        const Target y_pred = Predict::linreg(X, w);
-        const Derivative grad = -2.0 * arma::mean(X.t() * (y_true - y_pred), 1).t();
+        // Residuals and gradient in one expression: GEMV for predictions, transposed GEMV for gradient, no copy of X^T
+        const Derivative grad = -2.0 * (y_true - X * w.t()).t() * X;
         return grad;
     }
 
@@ -54,7 +58,7 @@ namespace DiffLoss
      * @param X Matrix of feature variables
      * @return const Derivative 
      */
-    static const Derivative mean_squared_error_loss_lapl(const Features& X)
+    inline const Derivative mean_squared_error_loss_lapl(const Features& X)
     {
         const Derivative lapl = 2.0 * arma::mean(X.t() * X, 1).t();
         return lapl;
@@ -70,7 +74,7 @@ namespace DiffLoss
      * @param y_true Column vector of target variable
      * @return const Derivative 
      */
-    static const Derivative mean_squared_error_loss_newton(const Weights& w, const Features& X, const Target& y_true)
+    inline const Derivative mean_squared_error_loss_newton(const Weights& w, const Features& X, const Target& y_true)
     {
         // Throw if X has more than one feature
         // Since, we add dummy feature for intercept weights, X will have two columns
@@ -98,10 +102,10 @@ namespace DiffLoss
      * @param y_true Column vector of target variable
      * @return const Derivative 
      */
-    static const Derivative log_likelihood_loss_grad(const Weights& w, const Features& X, const Target& y_true)
+    inline const Derivative log_likelihood_loss_grad(const Weights& w, const Features& X, const Target& y_true)
     {
-        const Target y_pred_proba = Predict::logreg_proba(X, w);
-        const Derivative grad = -arma::mean(X.t() * (y_true - y_pred_proba), 1).t();
+        // Residuals and gradient in one expression, no copy of X^T
+        const Derivative grad = -(y_true - Predict::logreg_proba(X, w)).t() * X;
         return grad;
     }
 
@@ -117,7 +121,7 @@ namespace DiffLoss
      * @param X Matrix of feature variables
      * @return const Derivative 
      */
-    static const Derivative log_likelihood_loss_lapl(const Weights& w, const Features& X)
+    inline const Derivative log_likelihood_loss_lapl(const Weights& w, const Features& X)
     {
         const Target y_pred_proba = Predict::logreg_proba(X, w);
         const Derivative lapl = arma::mean(X.t() * y_pred_proba * (1.0 - y_pred_proba).t(), 1).t();
@@ -134,7 +138,7 @@ namespace DiffLoss
      * @param y_true Column vector of target variable
      * @return const Derivative 
      */
-    static const Derivative log_likelihood_loss_newton(const Weights& w, const Features& X, const Target& y_true)
+    inline const Derivative log_likelihood_loss_newton(const Weights& w, const Features& X, const Target& y_true)
     {
         // Throw if X has more than one feature
         // Since, we add dummy feature for intercept weights, X will have two columns
@@ -149,28 +153,296 @@ namespace DiffLoss
     }
 
     /**
-     * @brief Alias for `mean_squared_error_loss_grad` function.
+     * @brief Gradient (first derivative) of Cross-Entropy (multinomial log likelihood) loss.
+     * 
+     * \f$ \displaystyle \nabla L_{CE} = X^T (\hat{P} - Y) \f$,
+     * where \f$ X \f$ is the features matrix,
+     * \f$ \hat{P} \f$ is the matrix of predicted class probabilities,
+     * \f$ Y \f$ is the one-hot encoded target matrix.
+     * 
+     * Gradient is summed, not averaged, over observations, as gradients above are. 
+     * Throws `WrongLabelsException`, if a label is not an integer in range [0, K).
+     * 
+     * Weights of all K classes are passed as one flattened (column-major) row vector of \f$ d \times K \f$ weights,
+     * so that the gradient of all classes is computed in one pass over the data, with one GEMM for scores and one for the gradient.
+     * One-hot target is never materialized, the true class probability is decremented in place.
+     * 
+     * @param w Row vector of flattened weights
+     * @param X Matrix of feature variables
+     * @param y_true Column vector of target variable (class labels 0, 1, ..., K - 1)
+     * @return const Derivative 
+     */
+    inline const Derivative cross_entropy_loss_grad(const Weights& w, const Features& X, const Target& y_true)
+    {
+        // View flattened weights as d x K matrix without copying
+        const ClassWeights W(const_cast<double*>(w.memptr()), X.n_cols, w.n_cols / X.n_cols, false, true);
+        // Labels index columns of probabilities, so they are checked before any write
+        for (arma::uword i = 0; i < X.n_rows; ++i)
+            if (y_true(i) < 0.0 || y_true(i) >= static_cast<double>(W.n_cols) || y_true(i) != std::floor(y_true(i)))
+                throw WrongLabelsException(y_true(i), W.n_cols);
+        Probabilities resid = Predict::softmax_proba(X, W);
+        for (arma::uword i = 0; i < X.n_rows; ++i)
+            resid(i, static_cast<arma::uword>(y_true(i))) -= 1.0;
+        const ClassWeights grad = X.t() * resid;
+        return Derivative(grad.memptr(), grad.n_elem);
+    }
+
+    /**
+     * @brief Stateless functor for `mean_squared_error_loss_grad` function.
+     * 
+     * Loss functors are resolved at compile time by `TypedDerivativeSolver`, so the call is inlined into optimization loop.
+     * 
+     * Gradient is a sum over observations, so it is row-separable: 
+     * derivative on all rows is `scale()` of the sum of `partial()` derivatives on disjoint blocks of rows.
+     * 
+     */
+    struct MeanSquaredErrorLossGrad
+    {
+        /**
+         * @brief Derivative can be reduced over blocks of rows.
+         * 
+         */
+        static constexpr bool row_separable = true;
+
+        const Derivative operator()(const Weights& w, const Features& X, const Target& y_true) const
+        {
+            return mean_squared_error_loss_grad(w, X, y_true);
+        }
+
+        const bool is_row_separable() const
+        {
+            return true;
+        }
+
+        const Derivative partial(const Weights& w, const Features& X, const Target& y_true) const
+        {
+            return mean_squared_error_loss_grad(w, X, y_true);
+        }
+
+        const Derivative scale(const Derivative& sum, const size_t num_rows) const
+        {
+            return sum;
+        }
+    };
+
+    /**
+     * @brief Stateless functor for `mean_squared_error_loss_newton` function.
+     * 
+     * Newton step is a ratio of sums, so it is not row-separable.
+     * 
+     */
+    struct MeanSquaredErrorLossNewton
+    {
+        /**
+         * @brief Derivative can not be reduced over blocks of rows.
+         * 
+         */
+        static constexpr bool row_separable = false;
+
+        const Derivative operator()(const Weights& w, const Features& X, const Target& y_true) const
+        {
+            return mean_squared_error_loss_newton(w, X, y_true);
+        }
+    };
+
+    /**
+     * @brief Stateless functor for `log_likelihood_loss_grad` function.
+     * 
+     * Gradient is a sum over observations, so it is row-separable.
+     * 
+     */
+    struct LogLikelihoodLossGrad
+    {
+        /**
+         * @brief Derivative can be reduced over blocks of rows.
+         * 
+         */
+        static constexpr bool row_separable = true;
+
+        const Derivative operator()(const Weights& w, const Features& X, const Target& y_true) const
+        {
+            return log_likelihood_loss_grad(w, X, y_true);
+        }
+
+        const bool is_row_separable() const
+        {
+            return true;
+        }
+
+        const Derivative partial(const Weights& w, const Features& X, const Target& y_true) const
+        {
+            return log_likelihood_loss_grad(w, X, y_true);
+        }
+
+        const Derivative scale(const Derivative& sum, const size_t num_rows) const
+        {
+            return sum;
+        }
+    };
+
+    /**
+     * @brief Stateless functor for `log_likelihood_loss_newton` function.
+     * 
+     * Newton step is a ratio of sums, so it is not row-separable.
+     * 
+     */
+    struct LogLikelihoodLossNewton
+    {
+        /**
+         * @brief Derivative can not be reduced over blocks of rows.
+         * 
+         */
+        static constexpr bool row_separable = false;
+
+        const Derivative operator()(const Weights& w, const Features& X, const Target& y_true) const
+        {
+            return log_likelihood_loss_newton(w, X, y_true);
+        }
+    };
+
+    /**
+     * @brief Stateless functor for `cross_entropy_loss_grad` function.
+     * 
+     * Gradient is a sum over observations, so it is row-separable.
+     * 
+     */
+    struct CrossEntropyLossGrad
+    {
+        /**
+         * @brief Derivative can be reduced over blocks of rows.
+         * 
+         */
+        static constexpr bool row_separable = true;
+
+        const Derivative operator()(const Weights& w, const Features& X, const Target& y_true) const
+        {
+            return cross_entropy_loss_grad(w, X, y_true);
+        }
+
+        const bool is_row_separable() const
+        {
+            return true;
+        }
+
+        const Derivative partial(const Weights& w, const Features& X, const Target& y_true) const
+        {
+            return cross_entropy_loss_grad(w, X, y_true);
+        }
+
+        const Derivative scale(const Derivative& sum, const size_t num_rows) const
+        {
+            return sum;
+        }
+    };
+
+    /**
+     * @brief Functor calling derivative of loss function chosen at runtime through `std::function`.
+     * 
+     * Keeps a copy of the function, so solvers may outlive the function they were constructed with (e.g. a lambda).
+     * Row-separable only if the function holds one of row-separable functors, as the aliases below do, 
+     * or one of gradient functions above.
+     * 
+     */
+    struct DynamicLoss
+    {
+        /**
+         * @brief Pointer to derivative of loss function, as held by `std::function` made of plain function.
+         * 
+         */
+        using DiffLossPtr = const Derivative (*)(const Weights&, const Features&, const Target&);
+
+        /**
+         * @brief Derivative of loss function.
+         * 
+         */
+        std::function<Derivative(const Weights&, const Features&, const Target&)> diff_loss_func;
+
+        /**
+         * @brief Derivative may be reduced over blocks of rows, checked at runtime with `is_row_separable()`.
+         * 
+         */
+        static constexpr bool row_separable = true;
+
+        const Derivative operator()(const Weights& w, const Features& X, const Target& y_true) const
+        {
+            return diff_loss_func(w, X, y_true);
+        }
+
+        const bool is_row_separable() const
+        {
+            return holds<MeanSquaredErrorLossGrad>(mean_squared_error_loss_grad)
+                || holds<LogLikelihoodLossGrad>(log_likelihood_loss_grad)
+                || holds<CrossEntropyLossGrad>(cross_entropy_loss_grad);
+        }
+
+        /**
+         * @brief Check, if the function holds Newton step, which is a ratio of sums over observations.
+         * 
+         * @return true, if Newton step
+         * @return false, if not or unknown
+         */
+        const bool is_newton() const
+        {
+            return holds<MeanSquaredErrorLossNewton>(mean_squared_error_loss_newton)
+                || holds<LogLikelihoodLossNewton>(log_likelihood_loss_newton);
+        }
+
+        const Derivative partial(const Weights& w, const Features& X, const Target& y_true) const
+        {
+            // Gradients of the library are sums over observations, so partial derivative is the derivative on the block
+            return diff_loss_func(w, X, y_true);
+        }
+
+        const Derivative scale(const Derivative& sum, const size_t num_rows) const
+        {
+            return sum;
+        }
+
+        /**
+         * @brief Check, if the function holds given functor or given plain function.
+         * 
+         * @tparam Functor Type of loss functor
+         * @param func Plain function equivalent to the functor
+         * @return true, if holds either
+         * @return false, if holds neither
+         */
+        template <typename Functor>
+        const bool holds(const DiffLossPtr func) const
+        {
+            const DiffLossPtr* ptr = diff_loss_func.target<DiffLossPtr>();
+            return diff_loss_func.target<Functor>() != nullptr || (ptr != nullptr && *ptr == func);
+        }
+    };
+
+    /**
+     * @brief Alias for `mean_squared_error_loss_grad` function, holds `MeanSquaredErrorLossGrad` functor.
+     * 
+     */
+    static const std::function<Derivative(const Weights&, const Features&, const Target&)> MEAN_SQUARED_ERROR_LOSS_GRAD = MeanSquaredErrorLossGrad();
+
+    /**
+     * @brief Alias for `mean_squared_error_loss_newton` function, holds `MeanSquaredErrorLossNewton` functor.
      * 
      */
-    static const std::function<Derivative(const Weights&, const Features&, const Target&)> MEAN_SQUARED_ERROR_LOSS_GRAD = mean_squared_error_loss_grad;
+    static const std::function<Derivative(const Weights&, const Features&, const Target&)> MEAN_SQUARED_ERROR_LOSS_NEWTON = MeanSquaredErrorLossNewton();
 
     /**
-     * @brief Alias for `mean_squared_error_loss_newton` function.
+     * @brief Alias for `log_likelihood_loss_grad` function, holds `LogLikelihoodLossGrad` functor.
      * 
      */
-    static const std::function<Derivative(const Weights&, const Features&, const Target&)> MEAN_SQUARED_ERROR_LOSS_NEWTON = mean_squared_error_loss_newton;
+    static const std::function<Derivative(const Weights&, const Features&, const Target&)> LOG_LIKELIHOOD_LOSS_GRAD = LogLikelihoodLossGrad();
 
     /**
-     * @brief Alias for `log_likelihood_loss_grad` function.
+     * @brief Alias for `log_likelihood_loss_newton` function, holds `LogLikelihoodLossNewton` functor.
      * 
      */
-    static const std::function<Derivative(const Weights&, const Features&, const Target&)> LOG_LIKELIHOOD_LOSS_GRAD = log_likelihood_loss_grad;
+    static const std::function<Derivative(const Weights&, const Features&, const Target&)> LOG_LIKELIHOOD_LOSS_NEWTON = LogLikelihoodLossNewton();
 
     /**
-     * @brief Alias for `log_likelihood_loss_newton` function.
+     * @brief Alias for `cross_entropy_loss_grad` function, holds `CrossEntropyLossGrad` functor.
      * 
      */
-    static const std::function<Derivative(const Weights&, const Features&, const Target&)> LOG_LIKELIHOOD_LOSS_NEWTON = log_likelihood_loss_newton;
+    static const std::function<Derivative(const Weights&, const Features&, const Target&)> CROSS_ENTROPY_LOSS_GRAD = CrossEntropyLossGrad();
 
 }
 
@@ -0,0 +1,117 @@
+/**
+ * @file elastic_net_solver.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief ElasticNetSolver class declarations
+ * @version 0.1
+ * @date 2024-05-15
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef ELASTIC_NET_SOLVER_HPP
+#define ELASTIC_NET_SOLVER_HPP
+
+#include "types.hpp"
+#include "base_solver.hpp"
+
+using namespace Types;
+
+/**
+ * @brief Lasso / Elastic-Net (L1/L2-regularized least squares) coordinate descent solver class. Inherits from `BaseSolver` class.
+ * 
+ * Minimizes \f$ \displaystyle \frac{1}{2n} \| y - X w \|^2 + \lambda \left( \alpha \| w_{1 \ldots d} \|_1 + \frac{1 - \alpha}{2} \| w_{1 \ldots d} \|^2 \right) \f$ 
+ * for every \f$ \lambda \f$ of the grid (path). Intercept weight \f$ w_0 \f$ (first, dummy feature added by models) is not penalized.
+ * 
+ * Speed-ups: covariance updates (columns of Gram matrix are computed only for features which enter the model), 
+ * strong-rule feature screening with KKT checks, active-set cycling and warm starts along the path.
+ * 
+ * https://www.jstatsoft.org/article/view/v033i01
+ */
+class ElasticNetSolver : public BaseSolver
+{
+    public:
+        
+        /**
+         * @brief Construct a new Elastic-Net Solver object.
+         * 
+         * @param lambdas Regularization strengths, preferably decreasing (warm starts)
+         * @param alpha Mixing of L1 and L2 penalties in (0, 1]: 1 is Lasso
+         * @param tol Convergence tolerance of coordinate descent
+         * @param max_iter Max number of coordinate descent passes per regularization strength
+         */
+        ElasticNetSolver(const Lambdas& lambdas, const double alpha=1.0, const double tol=1e-7, const size_t max_iter=1000);
+        
+        /**
+         * @brief Return optimized weights for \f$ \lambda \f$ of the grid with min Generalized Cross-Validation error.
+         * 
+         * Degrees of freedom of every \f$ \lambda \f$ are estimated as number of non-zero weights.
+         * 
+         * @param w Row vector of weights -- not used
+         * @param X Matrix of feature variables, first column is intercept (dummy) feature
+         * @param y Column vector of target variable
+         * @return Weights 
+         */
+        const Weights optimize(Weights& w, const Features& X, const Target& y);
+
+        /**
+         * @brief Get weights of whole regularization path, one row per \f$ \lambda \f$ of the grid.
+         * 
+         * @return const BatchWeights 
+         */
+        const BatchWeights get_path() const;
+
+        /**
+         * @brief Get regularization strengths of the grid.
+         * 
+         * @return const Lambdas 
+         */
+        const Lambdas get_lambdas() const;
+
+        /**
+         * @brief Get Generalized Cross-Validation error, one per \f$ \lambda \f$ of the grid.
+         * 
+         * @return const Target 
+         */
+        const Target get_gcv() const;
+
+    private:
+
+        /**
+         * @brief Regularization strengths.
+         * 
+         */
+        Lambdas lambdas_;
+
+        /**
+         * @brief Mixing of L1 and L2 penalties.
+         * 
+         */
+        double alpha_;
+
+        /**
+         * @brief Convergence tolerance.
+         * 
+         */
+        double tol_;
+
+        /**
+         * @brief Max number of coordinate descent passes.
+         * 
+         */
+        size_t max_iter_;
+
+        /**
+         * @brief Weights of regularization path, one row per \f$ \lambda \f$.
+         * 
+         */
+        BatchWeights path_;
+
+        /**
+         * @brief Generalized Cross-Validation error, one per \f$ \lambda \f$.
+         * 
+         */
+        Target gcv_;
+};
+
+#endif
@@ -84,4 +84,442 @@ class NewtonShapeException : public std::exception
 
 };
 
+/**
+ * @brief WrongOrderException class. Inherits from std::exception class.
+ * 
+ */
+class WrongOrderException : public std::exception
+{
+    public:
+    
+        /**
+         * @brief Construct a new WrongOrderException object.
+         * 
+         */
+        WrongOrderException()
+        { }
+
+        /**
+         * @brief Return detailed description of exception.
+         * 
+         * @return const std::string 
+         */
+        const std::string what()
+        {
+            const std::string message = "\n\033[91mWrongOrderException: \033[33mOrder p must be in range [1, length of time series)\033[0m\n";
+            return message;
+        }
+    
+    private:
+
+        // Add private member, if needed
+
+};
+
+/**
+ * @brief ConstantSeriesException class. Inherits from std::exception class.
+ * 
+ */
+class ConstantSeriesException : public std::exception
+{
+    public:
+    
+        /**
+         * @brief Construct a new ConstantSeriesException object.
+         * 
+         */
+        ConstantSeriesException()
+        { }
+
+        /**
+         * @brief Return detailed description of exception.
+         * 
+         * @return const std::string 
+         */
+        const std::string what()
+        {
+            const std::string message = "\n\033[91mConstantSeriesException: \033[33mTime series must not be constant\033[0m\n";
+            return message;
+        }
+    
+    private:
+
+        // Add private member, if needed
+
+};
+
+/**
+ * @brief LagsShapeException class. Inherits from std::exception class.
+ * 
+ */
+class LagsShapeException : public std::exception
+{
+    public:
+    
+        /**
+         * @brief Construct a new LagsShapeException object.
+         * 
+         * @param p Order of lag of fitted model
+         */
+        LagsShapeException(const size_t p)
+        : p_(p)
+        { }
+
+        /**
+         * @brief Return detailed description of exception.
+         * 
+         * @return const std::string 
+         */
+        const std::string what()
+        {
+            const std::string message = "\n\033[91mLagsShapeException: \033[33mX must have intercept feature and p = " + std::to_string(p_) + " lag features, as fitted\033[0m\n";
+            return message;
+        }
+    
+    private:
+
+        /**
+         * @brief Order of lag of fitted model.
+         * 
+         */
+        size_t p_;
+
+};
+
+/**
+ * @brief WrongFoldsException class. Inherits from std::exception class.
+ * 
+ */
+class WrongFoldsException : public std::exception
+{
+    public:
+    
+        /**
+         * @brief Construct a new WrongFoldsException object.
+         * 
+         */
+        WrongFoldsException()
+        { }
+
+        /**
+         * @brief Return detailed description of exception.
+         * 
+         * @return const std::string 
+         */
+        const std::string what()
+        {
+            const std::string message = "\n\033[91mWrongFoldsException: \033[33mNumber of folds must be in range [2, number of observations]\033[0m\n";
+            return message;
+        }
+    
+    private:
+
+        // Add private member, if needed
+
+};
+
+/**
+ * @brief WeightsShapeException class. Inherits from std::exception class.
+ * 
+ */
+class WeightsShapeException : public std::exception
+{
+    public:
+    
+        /**
+         * @brief Construct a new WeightsShapeException object.
+         * 
+         */
+        WeightsShapeException()
+        { }
+
+        /**
+         * @brief Return detailed description of exception.
+         * 
+         * @return const std::string 
+         */
+        const std::string what()
+        {
+            const std::string message = "\n\033[91mWeightsShapeException: \033[33mInitial weights must have one weight per feature, intercept included\033[0m\n";
+            return message;
+        }
+    
+    private:
+
+        // Add private member, if needed
+
+};
+
+/**
+ * @brief NoEarlyStoppingException class. Inherits from std::exception class.
+ * 
+ */
+class NoEarlyStoppingException : public std::exception
+{
+    public:
+    
+        /**
+         * @brief Construct a new NoEarlyStoppingException object.
+         * 
+         * @param obj_name Object's name
+         */
+        NoEarlyStoppingException(const std::string& obj_name)
+        : obj_name_(obj_name)
+        { }
+
+        /**
+         * @brief Return detailed description of exception.
+         * 
+         * @return const std::string 
+         */
+        const std::string what()
+        {
+            const std::string message = "\n\033[91mNoEarlyStoppingException: \033[33m" + obj_name_ + "\033[0m must have early stopping set to use validation data\n";
+            return message;
+        }
+    
+    private:
+
+        /**
+         * @brief Object's name.
+         * 
+         */
+        std::string obj_name_;
+
+};
+
+/**
+ * @brief DataFileException class. Inherits from std::exception class.
+ * 
+ */
+class DataFileException : public std::exception
+{
+    public:
+    
+        /**
+         * @brief Construct a new DataFileException object.
+         * 
+         * @param path Path to data file
+         * @param reason What is wrong with the file
+         */
+        DataFileException(const std::string& path, const std::string& reason)
+        : path_(path)
+        , reason_(reason)
+        { }
+
+        /**
+         * @brief Return detailed description of exception.
+         * 
+         * @return const std::string 
+         */
+        const std::string what()
+        {
+            const std::string message = "\n\033[91mDataFileException: \033[33m" + path_ + "\033[0m " + reason_ + "\n";
+            return message;
+        }
+    
+    private:
+
+        /**
+         * @brief Path to data file.
+         * 
+         */
+        std::string path_;
+
+        /**
+         * @brief What is wrong with the file.
+         * 
+         */
+        std::string reason_;
+
+};
+
+/**
+ * @brief WrongBlockException class. Inherits from std::exception class.
+ * 
+ */
+class WrongBlockException : public std::exception
+{
+    public:
+    
+        /**
+         * @brief Construct a new WrongBlockException object.
+         * 
+         * @param block Index of requested block
+         * @param num_blocks Number of blocks
+         */
+        WrongBlockException(const size_t block, const size_t num_blocks)
+        : block_(block)
+        , num_blocks_(num_blocks)
+        { }
+
+        /**
+         * @brief Return detailed description of exception.
+         * 
+         * @return const std::string 
+         */
+        const std::string what()
+        {
+            const std::string message = "\n\033[91mWrongBlockException: \033[33mBlock " + std::to_string(block_) + "\033[0m must be in range [0, " + std::to_string(num_blocks_) + ")\n";
+            return message;
+        }
+    
+    private:
+
+        /**
+         * @brief Index of requested block.
+         * 
+         */
+        size_t block_;
+
+        /**
+         * @brief Number of blocks.
+         * 
+         */
+        size_t num_blocks_;
+
+};
+
+/**
+ * @brief WrongPathsException class. Inherits from std::exception class.
+ * 
+ */
+class WrongPathsException : public std::exception
+{
+    public:
+    
+        /**
+         * @brief Construct a new WrongPathsException object.
+         * 
+         */
+        WrongPathsException()
+        { }
+
+        /**
+         * @brief Return detailed description of exception.
+         * 
+         * @return const std::string 
+         */
+        const std::string what()
+        {
+            const std::string message = "\n\033[91mWrongPathsException: \033[33mNumber of periods and number of paths must be positive\033[0m\n";
+            return message;
+        }
+    
+    private:
+
+        // Add private member, if needed
+
+};
+
+/**
+ * @brief EmptyGridException class. Inherits from std::exception class.
+ * 
+ */
+class EmptyGridException : public std::exception
+{
+    public:
+    
+        /**
+         * @brief Construct a new EmptyGridException object.
+         * 
+         */
+        EmptyGridException()
+        { }
+
+        /**
+         * @brief Return detailed description of exception.
+         * 
+         * @return const std::string 
+         */
+        const std::string what()
+        {
+            const std::string message = "\n\033[91mEmptyGridException: \033[33mGrid of configurations must not be empty\033[0m\n";
+            return message;
+        }
+    
+    private:
+
+        // Add private member, if needed
+
+};
+
+/**
+ * @brief WrongLambdasException class. Inherits from std::exception class.
+ * 
+ */
+class WrongLambdasException : public std::exception
+{
+    public:
+    
+        /**
+         * @brief Construct a new WrongLambdasException object.
+         * 
+         */
+        WrongLambdasException()
+        { }
+
+        /**
+         * @brief Return detailed description of exception.
+         * 
+         * @return const std::string 
+         */
+        const std::string what()
+        {
+            const std::string message = "\n\033[91mWrongLambdasException: \033[33mRegularization strengths must not be empty and must be positive\033[0m\n";
+            return message;
+        }
+    
+    private:
+
+        // Add private member, if needed
+
+};
+
+/**
+ * @brief WrongLabelsException class. Inherits from std::exception class.
+ * 
+ */
+class WrongLabelsException : public std::exception
+{
+    public:
+    
+        /**
+         * @brief Construct a new WrongLabelsException object.
+         * 
+         * @param label Class label
+         * @param num_classes Number of classes
+         */
+        WrongLabelsException(const double label, const size_t num_classes)
+        : label_(label)
+        , num_classes_(num_classes)
+        { }
+
+        /**
+         * @brief Return detailed description of exception.
+         * 
+         * @return const std::string 
+         */
+        const std::string what()
+        {
+            const std::string message = "\n\033[91mWrongLabelsException: \033[33mClass label " + std::to_string(label_) + " is not an integer in [0, " + std::to_string(num_classes_) + ")\033[0m\n";
+            return message;
+        }
+    
+    private:
+
+        /**
+         * @brief Class label.
+         * 
+         */
+        double label_;
+
+        /**
+         * @brief Number of classes.
+         * 
+         */
+        size_t num_classes_;
+
+};
+
 #endif
@@ -0,0 +1,231 @@
+/**
+ * @file halving_search.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief HalvingSearch class declarations
+ * @version 0.1
+ * @date 2024-05-10
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef HALVING_SEARCH_HPP
+#define HALVING_SEARCH_HPP
+
+#include <functional>
+#include <vector>
+#include "types.hpp"
+
+using namespace Types;
+
+/**
+ * @brief Hyperparameter search for `DerivativeSolver` with successive halving.
+ * 
+ * Configurations (learning rate, min size of derivative) are taken from a grid or sampled from it at random. 
+ * All configurations are trained for `min_iter` iterations and scored on validation data, 
+ * then only the best \f$ 1 / \eta \f$ of them continue (from their current weights) with \f$ \eta \f$ times more iterations, 
+ * until one configuration is left or `max_iter` iterations are reached. 
+ * Configurations of every round are trained in parallel (OpenMP) on one shared read-only copy of features.
+ * 
+ * https://arxiv.org/abs/1502.07943
+ */
+class HalvingSearch
+{
+    public:
+
+        /**
+         * @brief Construct a new HalvingSearch object.
+         * 
+         * @param diff_loss_func Derivative of loss function, i.e. `DiffLoss::MEAN_SQUARED_ERROR_LOSS_GRAD`
+         * @param predict_func Prediction function, i.e. `Predict::linreg` or `Predict::logreg_proba`
+         * @param metric_func Validation metric, i.e. `Metrics::mse`
+         * @param learning_rates Candidate learning rates
+         * @param min_derivative_sizes Candidate min sizes of the vector of derivative
+         * @param min_iter Number of iterations of the first round
+         * @param max_iter Max number of iterations of any configuration
+         * @param eta Halving rate: keep best 1 / eta configurations and multiply iterations by eta every round
+         * @param greater_is_better Maximize (i.e. `Metrics::r2`) instead of minimize (i.e. `Metrics::mse`) metric
+         */
+        HalvingSearch(const std::function<Derivative(const Weights&, const Features&, const Target&)>& diff_loss_func,
+                      const std::function<Target(const Features&, const Weights&)>& predict_func,
+                      const std::function<double(const Target&, const Target&)>& metric_func,
+                      const std::vector<double>& learning_rates,
+                      const std::vector<double>& min_derivative_sizes,
+                      const size_t min_iter,
+                      const size_t max_iter,
+                      const size_t eta=3,
+                      const bool greater_is_better=false);
+
+        /**
+         * @brief Search over full grid of configurations.
+         * 
+         * Intercept feature is added to (copies of) features, same as models do. Throws `EmptyGridException`, if grid is empty.
+         * 
+         * @param X_train Matrix of training feature variables
+         * @param y_train Column vector of training target variable
+         * @param X_val Matrix of validation feature variables
+         * @param y_val Column vector of validation target variable
+         * @param seed Seed of initial weights, shared by all configurations
+         * @return HalvingSearch&
+         */
+        HalvingSearch& fit(const Features& X_train, const Target& y_train, const Features& X_val, const Target& y_val, const unsigned int seed=0);
+
+        /**
+         * @brief Search over random sample of configurations from grid.
+         * 
+         * Throws `EmptyGridException`, if grid is empty or no configurations are sampled.
+         * 
+         * @param X_train Matrix of training feature variables
+         * @param y_train Column vector of training target variable
+         * @param X_val Matrix of validation feature variables
+         * @param y_val Column vector of validation target variable
+         * @param num_samples Number of sampled configurations
+         * @param seed Seed of sampling and initial weights
+         * @return HalvingSearch&
+         */
+        HalvingSearch& fit_random(const Features& X_train, const Target& y_train, const Features& X_val, const Target& y_val, const size_t num_samples, const unsigned int seed);
+
+        /**
+         * @brief Get evaluated configurations, one row per configuration: learning rate, iterations trained, min size of derivative.
+         * 
+         * @return const Features 
+         */
+        const Features get_configs() const;
+
+        /**
+         * @brief Get last validation score of every configuration.
+         * 
+         * @return const Target 
+         */
+        const Target get_scores() const;
+
+        /**
+         * @brief Get best configuration: learning rate, iterations trained, min size of derivative.
+         * 
+         * @return const arma::drowvec 
+         */
+        const arma::drowvec get_best_config() const;
+
+        /**
+         * @brief Get weights learned with best configuration.
+         * 
+         * @return const Weights 
+         */
+        const Weights get_best_weights() const;
+
+        /**
+         * @brief Get validation score of best configuration.
+         * 
+         * @return const double 
+         */
+        const double get_best_score() const;
+
+        /**
+         * @brief Get search's name.
+         * 
+         * @return std::string 
+         */
+        const std::string get_name() const;
+
+    private:
+
+        /**
+         * @brief Run successive halving over given configurations.
+         * 
+         * @param X_train Matrix of training feature variables
+         * @param y_train Column vector of training target variable
+         * @param X_val Matrix of validation feature variables
+         * @param y_val Column vector of validation target variable
+         * @param configs Indices of (learning rate, min size of derivative) pairs of grid
+         * @param seed Seed of initial weights
+         */
+        void halve_(const Features& X_train, const Target& y_train, const Features& X_val, const Target& y_val, 
+                    const std::vector<size_t>& configs, const unsigned int seed);
+
+        /**
+         * @brief Derivative of loss function.
+         * 
+         */
+        std::function<Derivative(const Weights&, const Features&, const Target&)> diff_loss_func_;
+
+        /**
+         * @brief Prediction function.
+         * 
+         */
+        std::function<Target(const Features&, const Weights&)> predict_func_;
+
+        /**
+         * @brief Validation metric.
+         * 
+         */
+        std::function<double(const Target&, const Target&)> metric_func_;
+
+        /**
+         * @brief Candidate learning rates.
+         * 
+         */
+        std::vector<double> learning_rates_;
+
+        /**
+         * @brief Candidate min sizes of the vector of derivative.
+         * 
+         */
+        std::vector<double> min_derivative_sizes_;
+
+        /**
+         * @brief Number of iterations of the first round.
+         * 
+         */
+        size_t min_iter_;
+
+        /**
+         * @brief Max number of iterations of any configuration.
+         * 
+         */
+        size_t max_iter_;
+
+        /**
+         * @brief Halving rate.
+         * 
+         */
+        size_t eta_;
+
+        /**
+         * @brief Maximize metric flag.
+         * 
+         */
+        bool greater_is_better_;
+
+        /**
+         * @brief Evaluated configurations.
+         * 
+         */
+        Features configs_;
+
+        /**
+         * @brief Last validation score of every configuration.
+         * 
+         */
+        Target scores_;
+
+        /**
+         * @brief Index of best configuration.
+         * 
+         */
+        size_t best_;
+
+        /**
+         * @brief Weights learned with best configuration.
+         * 
+         */
+        Weights best_weights_;
+
+        /**
+         * @brief Search's name (string).
+         * 
+         */
+        std::string name_;
+        
+};
+
+#endif
@@ -14,13 +14,14 @@
 
 #include "types.hpp"
 #include "base_model.hpp"
+#include "block_source.hpp"
 
 using namespace Types;
 
 /**
  * @brief Linear Regression model class template. Inherits from `BaseModel` class.
  * 
- * @tparam SolverType class of solver: `BaseSolver`, `OLSSolver`, `QRSolver`, `DerivativeSolver`
+ * @tparam SolverType class of solver: `BaseSolver`, `OLSSolver`, `QRSolver`, `DerivativeSolver`, `TypedDerivativeSolver`, `RidgeSolver`, `ElasticNetSolver`
  */
 template <typename SolverType>
 class LinRegModel : public BaseModel
@@ -37,18 +38,49 @@ class LinRegModel : public BaseModel
         /**
          * @brief Get model's weights.
          * 
-         * @return const Weights 
+         * @return const Weights& 
          */
-        const Weights get_weights() const;
+        const Weights& get_weights() const;
+
+        /**
+         * @brief Get solver the model is fitted with, i.e. to inspect solver's results.
+         * 
+         * @return const SolverType& 
+         */
+        const SolverType& get_solver() const;
 
         /**
          * @brief Fit model.
          * 
          * @param X Matrix of feature variables
          * @param y Column vector of target variable
-         * @return LinRegModel
+         * @return LinRegModel&
+         */
+        LinRegModel& fit(Features& X, const Target& y);
+
+        /**
+         * @brief Fit model on data streamed in blocks, i.e. larger than memory.
+         * 
+         * Blocks already have intercept (dummy) feature, so no features matrix is changed or held in full.
+         * Supported by `OLSSolver`, `QRSolver`, `RidgeSolver` (one pass) and `DerivativeSolver` (one pass per iteration).
+         * 
+         * @param source Source of blocks of data
+         * @return LinRegModel&
+         */
+        LinRegModel& fit(const BlockSource& source);
+
+        /**
+         * @brief Fit model with early stopping on validation data, best weights on validation data are kept.
+         * 
+         * Supported by `DerivativeSolver` and `TypedDerivativeSolver` with early stopping set.
+         * 
+         * @param X Matrix of feature variables
+         * @param y Column vector of target variable
+         * @param X_val Matrix of validation feature variables
+         * @param y_val Column vector of validation target variable
+         * @return LinRegModel&
          */
-        const LinRegModel fit(Features& X, const Target& y);
+        LinRegModel& fit(Features& X, const Target& y, const Features& X_val, const Target& y_val);
 
         /**
          * @brief Predict target variable with fitted model.
@@ -58,6 +90,16 @@ class LinRegModel : public BaseModel
          */
         const Target predict(const Features& X) const;
 
+        /**
+         * @brief Predict target variable with fitted model into output buffer, which is resized only if needed.
+         * 
+         * Reusing the buffer across calls avoids allocation in scoring loops.
+         * 
+         * @param X Matrix of feature variables
+         * @param out Output column vector of target variable
+         */
+        void predict_into(const Features& X, Target& out) const;
+
     private:
         
         /**
@@ -14,6 +14,7 @@
 
 #include "types.hpp"
 #include "base_model.hpp"
+#include "block_source.hpp"
 #include "base_solver.hpp"
 #include "derivative_solver.hpp"
 
@@ -22,7 +23,7 @@ using namespace Types;
 /**
  * @brief Logistic Regression model class template. Inherits from `BaseModel` class.
  * 
- * @tparam SolverType class of solver: `BaseSolver`, `DerivativeSolver`
+ * @tparam SolverType class of solver: `BaseSolver`, `DerivativeSolver`, `TypedDerivativeSolver`
  */
 template <typename SolverType>
 class LogRegModel : public BaseModel
@@ -39,18 +40,42 @@ class LogRegModel : public BaseModel
         /**
          * @brief Get model's weights.
          * 
-         * @return const Weights 
+         * @return const Weights& 
          */
-        const Weights get_weights() const;
+        const Weights& get_weights() const;
 
         /**
          * @brief Fit model.
          * 
          * @param X Matrix of feature variables
          * @param y Column vector of target variable
-         * @return LogRegModel
+         * @return LogRegModel&
          */
-        const LogRegModel fit(Features& X, const Target& y);
+        LogRegModel& fit(Features& X, const Target& y);
+
+        /**
+         * @brief Fit model on data streamed in blocks, i.e. larger than memory.
+         * 
+         * Blocks already have intercept (dummy) feature, so no features matrix is changed or held in full.
+         * Supported by `DerivativeSolver` (one pass per iteration).
+         * 
+         * @param source Source of blocks of data
+         * @return LogRegModel&
+         */
+        LogRegModel& fit(const BlockSource& source);
+
+        /**
+         * @brief Fit model with early stopping on validation data, best weights on validation data are kept.
+         * 
+         * Supported by `DerivativeSolver` and `TypedDerivativeSolver` with early stopping set.
+         * 
+         * @param X Matrix of feature variables
+         * @param y Column vector of target variable
+         * @param X_val Matrix of validation feature variables
+         * @param y_val Column vector of validation target variable
+         * @return LogRegModel&
+         */
+        LogRegModel& fit(Features& X, const Target& y, const Features& X_val, const Target& y_val);
 
         /**
          * @brief Predict (classify) target variable's class with fitted model at given threshold.
@@ -71,6 +96,23 @@ class LogRegModel : public BaseModel
          */
         const Target predict_proba(const Features& X) const;
 
+        /**
+         * @brief Predict (classify) target variable's class with fitted model at given threshold into output buffer, which is resized only if needed.
+         * 
+         * @param X Matrix of feature variables
+         * @param out Output column vector of classes
+         * @param threshold Threshold [0, 1] (double)
+         */
+        void predict_into(const Features& X, Target& out, const double threshold=0.5) const;
+
+        /**
+         * @brief Predict probability of positive class of target variable with fitted model into output buffer, which is resized only if needed.
+         * 
+         * @param X Matrix of feature variables
+         * @param out Output column vector of probabilities
+         */
+        void predict_proba_into(const Features& X, Target& out) const;
+
     private:
         
         /**
@@ -0,0 +1,80 @@
+/**
+ * @file mapped_file.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief MappedFile class declarations
+ * @version 0.1
+ * @date 2024-05-27
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <string>
+
+/**
+ * @brief Memory mapping of a whole file, unmapped on destruction.
+ * 
+ * Mapping is private: if it is writable, writes are copy-on-write and never reach the file.
+ */
+class MappedFile
+{
+    public:
+
+        /**
+         * @brief Construct a new MappedFile object. Throws `DataFileException`, if file cannot be mapped.
+         * 
+         * @param path Path to file
+         * @param writable Map pages as writable (copy-on-write), e.g. to hand them out as non-const matrices
+         */
+        MappedFile(const std::string& path, const bool writable=false);
+
+        /**
+         * @brief Destroy the MappedFile object and unmap file.
+         * 
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Get start of mapped file, `nullptr` if file is empty.
+         * 
+         * @return char* 
+         */
+        char* begin() const;
+
+        /**
+         * @brief Get end of mapped file.
+         * 
+         * @return char* 
+         */
+        char* end() const;
+
+        /**
+         * @brief Get size of mapped file in bytes.
+         * 
+         * @return size_t 
+         */
+        size_t size() const;
+
+    private:
+
+        /**
+         * @brief Start of mapped file.
+         * 
+         */
+        char* data_;
+
+        /**
+         * @brief Size of mapped file in bytes.
+         * 
+         */
+        size_t size_;
+
+};
+
+#endif
@@ -14,6 +14,7 @@
 
 #include "types.hpp"
 #include "base_solver.hpp"
+#include "block_source.hpp"
 
 using namespace Types;
 
@@ -42,6 +43,19 @@ class OLSSolver : public BaseSolver
          */
         const Weights optimize(Weights& w, const Features& X, const Target& y);
 
+        /**
+         * @brief Return optimized weights from data streamed in blocks, in one pass.
+         * 
+         * Centered normal equations are solved from means and scatter matrix accumulated over blocks:
+         * 
+         * \f$ \displaystyle C_{xx} w_{1 \ldots d} = C_{xy}, \quad w_{0} = \bar{y} - \bar{x}^T w_{1 \ldots d} \f$
+         * 
+         * @param w Row vector of weights -- not used
+         * @param source Source of blocks of data
+         * @return Weights 
+         */
+        const Weights optimize(Weights& w, const BlockSource& source);
+
     private:
 
         // Add private members, if needed
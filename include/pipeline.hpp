@@ -0,0 +1,116 @@
+/**
+ * @file pipeline.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief Pipeline class declarations
+ * @version 0.1
+ * @date 2024-05-22
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include "types.hpp"
+#include "base_model.hpp"
+
+using namespace Types;
+
+/**
+ * @brief Pipeline of transformer and linear model class template. Inherits from `BaseModel` class.
+ * 
+ * After fitting, the (affine) transformation is folded into model's weights and intercept,
+ * so raw features are scored with a single matrix-vector product, without transformed copy of features.
+ * 
+ * Pipeline holds exactly one transformer. Transformers of the library (`BaseTransformer`, `StandardScaler`) are affine, 
+ * and so is any chain of them, so a sequence of transformers is not supported: it would fold into the same weights as one transformer.
+ * 
+ * @tparam TransformerType class of transformer: `BaseTransformer`, `StandardScaler`
+ * @tparam ModelType class of model: `LinRegModel`, `LogRegModel`, `SoftmaxRegModel`
+ */
+template <typename TransformerType, typename ModelType>
+class Pipeline : public BaseModel
+{
+    public:
+
+        /**
+         * @brief Construct a new Pipeline object.
+         * 
+         * @param transformer Transformer to apply to features first
+         * @param model Model to fit on transformed features
+         */
+        Pipeline(const TransformerType& transformer, const ModelType& model);
+
+        /**
+         * @brief Get folded weights that score raw features, intercept in the first row, one column per output.
+         * 
+         * @return const ClassWeights& 
+         */
+        const ClassWeights& get_weights() const;
+
+        /**
+         * @brief Get fitted transformer.
+         * 
+         * @return const TransformerType& 
+         */
+        const TransformerType& get_transformer() const;
+
+        /**
+         * @brief Get fitted model.
+         * 
+         * @return const ModelType& 
+         */
+        const ModelType& get_model() const;
+
+        /**
+         * @brief Fit transformer, then fit model on transformed features, then fold transformation into model's weights.
+         * 
+         * @param X Matrix of feature variables (raw)
+         * @param y Column vector of target variable
+         * @return Pipeline& 
+         */
+        Pipeline& fit(Features& X, const Target& y);
+
+        /**
+         * @brief Predict target variable from raw features with folded weights.
+         * 
+         * Output is the same as model's `predict()` on transformed features:
+         * value for `LinRegModel`, class at 0.5 threshold for `LogRegModel`, most probable class for `SoftmaxRegModel`.
+         * 
+         * @param X Matrix of feature variables (raw, without dummy feature)
+         * @return const Target 
+         */
+        const Target predict(const Features& X) const;
+
+        /**
+         * @brief Predict target variable from raw features with folded weights into output buffer, which is resized only if needed.
+         * 
+         * @param X Matrix of feature variables (raw, without dummy feature)
+         * @param out Output column vector of predictions
+         */
+        void predict_into(const Features& X, Target& out) const;
+
+    private:
+
+        /**
+         * @brief Transformer to apply to features.
+         * 
+         */
+        TransformerType transformer_;
+
+        /**
+         * @brief Model to fit on transformed features.
+         * 
+         */
+        ModelType model_;
+
+        /**
+         * @brief Folded weights, intercept in the first row, one column per output.
+         * 
+         */
+        ClassWeights weights_;
+
+};
+
+#endif
@@ -91,6 +91,72 @@ namespace Predict
         return y_pred;
     }
 
+    /**
+     * @brief Softmax function, applied to each row of scores in place, so that scores buffer can be reused.
+     * 
+     * Subtracting the row max keeps `exp()` from overflowing for large scores.
+     * 
+     * @param z Matrix of scores, one column per class, overwritten with probabilities
+     */
+    static void softmax_function_inplace(Probabilities& z)
+    {
+        z.each_col() -= arma::max(z, 1);
+        z = arma::exp(z);
+        z.each_col() /= arma::sum(z, 1);
+    }
+
+    /**
+     * @brief Softmax function, applied to each row of scores.
+     * 
+     * \f$ \displaystyle \sigma(z)_{ik} = \frac{e^{z_{ik} - m_{i}}}{\sum_{j=1}^{K} e^{z_{ij} - m_{i}}}, \quad m_{i} = \max_{j} z_{ij} \f$
+     * 
+     * Subtracting the row max keeps `exp()` from overflowing for large scores.
+     * 
+     * @param z Matrix of scores, one column per class
+     * @return const Types::Probabilities 
+     */
+    static const Probabilities softmax_function(Probabilities z)
+    {
+        softmax_function_inplace(z);
+        return z;
+    }
+
+    /**
+     * @brief Predict probabilities of all classes for multinomial (softmax) regression.
+     * 
+     * \f$ \displaystyle \hat{P} = \sigma(X W) \f$,
+     * 
+     * where \f$ \sigma(z) \f$ is the softmax function,
+     * \f$ X \f$ is the features matrix,
+     * \f$ W \f$ is the model's weights matrix (one column per class).
+     * 
+     * All classes are scored with a single matrix product (GEMM).
+     * 
+     * @param X Matrix of feature variables
+     * @param W Matrix of weights, one column per class
+     * @return const Types::Probabilities 
+     */
+    static const Probabilities softmax_proba(const Features& X, const ClassWeights& W)
+    {
+        const Probabilities proba = softmax_function(X * W);
+        return proba;
+    }
+
+    /**
+     * @brief Predict class for multinomial (softmax) regression.
+     * Classes are labeled 0, 1, ..., K - 1.
+     * 
+     * \f$ \displaystyle \hat{y}_{i} = \arg\max_{k} \hat{P}_{ik} \f$
+     * 
+     * @param proba Predicted probabilities, one column per class
+     * @return const Types::Target 
+     */
+    static const Target softmax_class(const Probabilities& proba)
+    {
+        const Target y_pred = arma::conv_to<Target>::from(arma::index_max(proba, 1));
+        return y_pred;
+    }
+
     /**
      * @brief Compute weights for Ordinary Least Squares.
      *
@@ -14,6 +14,7 @@
 
 #include "types.hpp"
 #include "base_solver.hpp"
+#include "block_source.hpp"
 
 using namespace Types;
 
@@ -44,6 +45,18 @@ class QRSolver : public BaseSolver
          */
         const Weights optimize(Weights& w, const Features& X, const Target& y);
 
+        /**
+         * @brief Return optimized weights from data streamed in blocks, in one pass (tall-skinny QR).
+         * 
+         * Triangular factor of \f$ [X, y] \f$ is updated block by block, \f$ R \leftarrow qr([R; X_{b}, y_{b}]) \f$, 
+         * so only \f$ (d + 2) \times (d + 2) \f$ factor is kept between blocks and normal equations are never formed.
+         * 
+         * @param w Row vector of weights -- not used
+         * @param source Source of blocks of data
+         * @return Weights 
+         */
+        const Weights optimize(Weights& w, const BlockSource& source);
+
     private:
 
         // Add private members, if needed
@@ -0,0 +1,136 @@
+/**
+ * @file ridge_solver.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief RidgeSolver class declarations
+ * @version 0.1
+ * @date 2024-05-13
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef RIDGE_SOLVER_HPP
+#define RIDGE_SOLVER_HPP
+
+#include "types.hpp"
+#include "base_solver.hpp"
+#include "block_source.hpp"
+
+using namespace Types;
+
+/**
+ * @brief Ridge (L2-regularized least squares) solver class. Inherits from `BaseSolver` class.
+ * 
+ * Minimizes \f$ \| y - X w \|^2 + \lambda \| w_{1 \ldots d} \|^2 \f$ for every \f$ \lambda \f$ of the grid. 
+ * Intercept weight \f$ w_0 \f$ (first, dummy feature added by models) is not penalized.
+ */
+class RidgeSolver : public BaseSolver
+{
+    public:
+        
+        /**
+         * @brief Construct a new Ridge Solver object for a single regularization strength.
+         * 
+         * https://en.wikipedia.org/wiki/Ridge_regression
+         * Throws `WrongLambdasException`, if strength is not positive.
+         * 
+         * @param lambda Regularization strength, positive
+         */
+        RidgeSolver(const double lambda);
+
+        /**
+         * @brief Construct a new Ridge Solver object for a grid (path) of regularization strengths.
+         * Throws `WrongLambdasException`, if grid is empty or any strength is not positive.
+         * 
+         * @param lambdas Regularization strengths, positive
+         */
+        RidgeSolver(const Lambdas& lambdas);
+        
+        /**
+         * @brief Return optimized weights for \f$ \lambda \f$ of the grid with min Generalized Cross-Validation error.
+         * 
+         * Whole regularization path is computed from a single eigendecomposition 
+         * of centered Gram matrix \f$ X^T X = V \Lambda V^T \f$:
+         * 
+         * \f$ \displaystyle w(\lambda) = V (\Lambda + \lambda I)^{-1} V^T X^T y \f$,
+         * 
+         * i.e. every \f$ \lambda \f$ costs \f$ O(d^2) \f$ with no refactoring.
+         * 
+         * \f$ \displaystyle GCV(\lambda) = \frac{n \, SSE(\lambda)}{(n - df(\lambda))^2} \f$, 
+         * \f$ \displaystyle df(\lambda) = \sum_{i} \frac{\lambda_{i}}{\lambda_{i} + \lambda} \f$.
+         * 
+         * @param w Row vector of weights -- not used
+         * @param X Matrix of feature variables, first column is intercept (dummy) feature
+         * @param y Column vector of target variable
+         * @return Weights 
+         */
+        const Weights optimize(Weights& w, const Features& X, const Target& y);
+
+        /**
+         * @brief Return optimized weights for \f$ \lambda \f$ of the grid with min Generalized Cross-Validation error, 
+         * from data streamed in blocks, in one pass.
+         * 
+         * Centered Gram matrix is taken from means and scatter matrix accumulated over blocks, the rest is the same as in-memory path.
+         * 
+         * @param w Row vector of weights -- not used
+         * @param source Source of blocks of data
+         * @return Weights 
+         */
+        const Weights optimize(Weights& w, const BlockSource& source);
+
+        /**
+         * @brief Get weights of whole regularization path, one row per \f$ \lambda \f$ of the grid.
+         * 
+         * @return const BatchWeights 
+         */
+        const BatchWeights get_path() const;
+
+        /**
+         * @brief Get regularization strengths of the grid.
+         * 
+         * @return const Lambdas 
+         */
+        const Lambdas get_lambdas() const;
+
+        /**
+         * @brief Get Generalized Cross-Validation error, one per \f$ \lambda \f$ of the grid.
+         * 
+         * @return const Target 
+         */
+        const Target get_gcv() const;
+
+    private:
+
+        /**
+         * @brief Compute whole regularization path and GCV errors from centered sufficient statistics.
+         * 
+         * @param n Number of observations
+         * @param x_means Row vector of means of features
+         * @param y_mean Mean of target
+         * @param gram Centered Gram matrix of features
+         * @param moment Centered \f$ X^T y \f$ vector
+         * @param sst Centered total sum of squares of target
+         * @return Weights of \f$ \lambda \f$ with min GCV error
+         */
+        const Weights solve_path_(const size_t n, const Weights& x_means, const double y_mean, const Features& gram, const Target& moment, const double sst);
+
+        /**
+         * @brief Regularization strengths.
+         * 
+         */
+        Lambdas lambdas_;
+
+        /**
+         * @brief Weights of regularization path, one row per \f$ \lambda \f$.
+         * 
+         */
+        BatchWeights path_;
+
+        /**
+         * @brief Generalized Cross-Validation error, one per \f$ \lambda \f$.
+         * 
+         */
+        Target gcv_;
+};
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ * @file softmax_reg_model.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief SoftmaxRegModel class declarations
+ * @version 0.1
+ * @date 2024-05-20
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef SOFTMAX_REG_MODEL_HPP
+#define SOFTMAX_REG_MODEL_HPP
+
+#include "types.hpp"
+#include "base_model.hpp"
+#include "base_solver.hpp"
+#include "derivative_solver.hpp"
+
+using namespace Types;
+
+/**
+ * @brief Multinomial (Softmax) Regression model class template. Inherits from `BaseModel` class.
+ * 
+ * Learns one column of weights per class, all classes are trained jointly in one pass over the data per solver iteration.
+ * Use with `DiffLoss::CROSS_ENTROPY_LOSS_GRAD`.
+ * 
+ * @tparam SolverType class of solver: `BaseSolver`, `DerivativeSolver`, `TypedDerivativeSolver`
+ */
+template <typename SolverType>
+class SoftmaxRegModel : public BaseModel
+{
+    public:
+
+        /**
+         * @brief Construct a new SoftmaxRegModel object.
+         * 
+         */
+        SoftmaxRegModel(const SolverType& solver);
+
+        /**
+         * @brief Get model's weights, one column per class.
+         * 
+         * @return const ClassWeights& 
+         */
+        const ClassWeights& get_weights() const;
+
+        /**
+         * @brief Get number of classes learned by model.
+         * 
+         * @return const size_t 
+         */
+        const size_t get_num_classes() const;
+
+        /**
+         * @brief Fit model. Throws `WrongLabelsException`, if a label is not an integer in range [0, K).
+         * 
+         * @param X Matrix of feature variables
+         * @param y Column vector of target variable (class labels 0, 1, ..., K - 1)
+         * @return SoftmaxRegModel&
+         */
+        SoftmaxRegModel& fit(Features& X, const Target& y);
+
+        /**
+         * @brief Predict (classify) target variable's class with fitted model.
+         * 
+         * Predicted class is the one with max probability
+         * 
+         * @param X Matrix of feature variables
+         * @return const Target 
+         */
+        const Target predict(const Features& X) const;
+
+        /**
+         * @brief Predict probabilities of all classes of target variable with fitted model.
+         * 
+         * @param X Matrix of feature variables
+         * @return const Probabilities 
+         */
+        const Probabilities predict_proba(const Features& X) const;
+
+        /**
+         * @brief Predict (classify) target variable's class with fitted model into output buffer, which is resized only if needed.
+         * 
+         * Most probable class is the one with max score, so softmax is skipped. 
+         * Scores are computed blockwise into a local cache-sized buffer, so memory does not grow with number of rows.
+         * 
+         * @param X Matrix of feature variables
+         * @param out Output column vector of classes
+         */
+        void predict_into(const Features& X, Target& out) const;
+
+        /**
+         * @brief Predict probabilities of all classes of target variable with fitted model into output buffer, which is resized only if needed.
+         * 
+         * @param X Matrix of feature variables
+         * @param out Output matrix of probabilities, one column per class
+         */
+        void predict_proba_into(const Features& X, Probabilities& out) const;
+
+    private:
+        
+        /**
+         * @brief Matrix of model's weights, one column per class.
+         * 
+         */
+        ClassWeights weights_;
+        
+        /**
+         * @brief Solver to fit model with.
+         * 
+         */
+        SolverType solver_;
+        
+};
+
+#endif
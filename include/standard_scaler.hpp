@@ -36,9 +36,9 @@ class StandardScaler : public BaseTransformer
          * @brief Fit scaler.
          * 
          * @param X Matrix of feature variables
-         * @return StandardScaler
+         * @return StandardScaler&
          */
-        StandardScaler fit(Features& X);
+        StandardScaler& fit(Features& X);
 
         /**
          * @brief Transform feature variables with fitted scaler.
@@ -48,6 +48,16 @@ class StandardScaler : public BaseTransformer
          */
         const Features transform(Features& X);
 
+        /**
+         * @brief Transform feature variables with fitted scaler into output buffer, which is resized only if needed.
+         * 
+         * Column by column, so no temporary matrix of the shape of features is allocated.
+         * 
+         * @param X Matrix of feature variables
+         * @param out Output matrix of scaled features
+         */
+        void transform_into(const Features& X, Features& out) const;
+
         /**
          * @brief Fit scaler, then transform feature variables.
          * 
@@ -56,20 +66,33 @@ class StandardScaler : public BaseTransformer
          */
         const Features fit_transform(Features& X);
 
+        /**
+         * @brief Fold scaling into weights of linear model fitted on scaled features.
+         * 
+         * \f$ \displaystyle w_{j}' = \frac{w_{j}}{\sigma_{j}}, \quad w_{0}' = w_{0} - \sum_{j=1}^{d} w_{j}' \mu_{j} \f$,
+         * where \f$ \mu_{j} \f$ and \f$ \sigma_{j} \f$ are the learned mean and standard deviation of feature \f$ j \f$.
+         * 
+         * Folded weights score raw (unscaled) features directly, so no scaled copy of features is needed to predict.
+         * 
+         * @param W Matrix of weights, intercept in the first row, one column per output
+         * @return const ClassWeights 
+         */
+        const ClassWeights fold(const ClassWeights& W) const;
+
         /**
          * @brief Return matrix of learned means with shape of features.
          * 
-         * @return const Features 
+         * @return const Features& 
          */
-        const Features get_means() const;
+        const Features& get_means() const;
 
 
         /**
          * @brief Return matrix of learned standard deviations with shape of features.
          * 
-         * @return const Features 
+         * @return const Features& 
          */
-        const Features get_stddevs() const;
+        const Features& get_stddevs() const;
 
     private:
 
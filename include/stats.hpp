@@ -0,0 +1,166 @@
+/**
+ * @file stats.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief Stats struct and ScopedTimer class declarations, instrumentation macros
+ * @version 0.1
+ * @date 2024-06-07
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ * Instrumentation is compiled out, unless the library is built with `-DEZML_STATS`,
+ * then models, solvers and transformers record their phases into stats returned by `get_stats()`,
+ * and into trace, while `Trace` is recording. Const methods (predict, transform into buffer) may run on many threads at once,
+ * so they are recorded into trace only.
+ */
+
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#include "trace.hpp"
+
+/**
+ * @brief Accumulated wall time, calls and allocations of one phase.
+ * 
+ */
+struct PhaseStats
+{
+    double seconds = 0.0; ///< Total wall time, s
+    size_t calls = 0;     ///< Number of times phase was run
+    size_t bytes = 0;     ///< Total bytes allocated by phase, estimated from shapes of its buffers, not measured
+};
+
+/**
+ * @brief Instrumentation stats of object (model, solver or transformer).
+ * 
+ * Phases accumulate over object's lifetime, iterations describe the last optimization only.
+ * Stats are not synchronized, so they must be recorded from one thread, i.e. outside of parallel regions.
+ */
+struct Stats
+{
+    /**
+     * @brief Phases by name.
+     * 
+     */
+    std::map<std::string, PhaseStats> phases;
+
+    /**
+     * @brief Number of iterations of the last optimization.
+     * 
+     */
+    size_t num_iter = 0;
+
+    /**
+     * @brief Derivative 2-norm per iteration of the last optimization.
+     * 
+     */
+    std::vector<double> derivative_norms;
+
+    /**
+     * @brief Add bytes allocated by phase, estimated from shapes of its buffers.
+     * 
+     * @param phase Name of phase
+     * @param bytes Number of bytes
+     */
+    void add_bytes(const std::string& phase, const size_t bytes);
+
+    /**
+     * @brief Add iteration of optimization.
+     * 
+     * @param derivative_norm Derivative 2-norm at iteration
+     */
+    void add_iter(const double derivative_norm);
+
+    /**
+     * @brief Forget iterations of previous optimization.
+     * 
+     */
+    void reset_iters();
+
+    /**
+     * @brief Forget everything.
+     * 
+     */
+    void clear();
+};
+
+/**
+ * @brief Timer of phase: adds wall time between its construction and destruction to phase's stats, and records it to trace.
+ * 
+ */
+class ScopedTimer
+{
+    public:
+
+        /**
+         * @brief Construct a new ScopedTimer object and start timing.
+         * 
+         * @param stats Stats to record phase into
+         * @param owner Name of object the phase belongs to
+         * @param phase Name of phase
+         */
+        ScopedTimer(Stats& stats, const std::string& owner, const char* phase);
+
+        /**
+         * @brief Destroy the ScopedTimer object and record phase.
+         * 
+         */
+        ~ScopedTimer();
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+
+        /**
+         * @brief Stats of phase.
+         * 
+         */
+        PhaseStats& phase_;
+
+        /**
+         * @brief Name of object the phase belongs to.
+         * 
+         */
+        const std::string& owner_;
+
+        /**
+         * @brief Name of phase.
+         * 
+         */
+        const char* name_;
+
+        /**
+         * @brief Start time.
+         * 
+         */
+        Trace::Clock::time_point start_;
+
+};
+
+#define EZML_CONCAT_IMPL_(a, b) a##b
+#define EZML_CONCAT_(a, b) EZML_CONCAT_IMPL_(a, b)
+
+#ifdef EZML_STATS
+    /// Time the rest of enclosing scope as phase of object named `owner`
+    #define EZML_PHASE(stats, owner, phase) const ScopedTimer EZML_CONCAT_(ezml_timer_, __LINE__)((stats), (owner), (phase))
+    /// Trace the rest of enclosing scope, `(name)` or `(owner, name)`, safe in parallel regions and const methods
+    #define EZML_TRACE_SCOPE(...) const TraceScope EZML_CONCAT_(ezml_trace_, __LINE__)(__VA_ARGS__)
+    /// Add bytes allocated by phase, estimated from shapes of its buffers
+    #define EZML_BYTES(stats, phase, bytes) (stats).add_bytes((phase), (bytes))
+    /// Add iteration of optimization with its derivative 2-norm
+    #define EZML_ITER(stats, derivative_norm) (stats).add_iter(derivative_norm)
+    /// Forget iterations of previous optimization
+    #define EZML_RESET_ITERS(stats) (stats).reset_iters()
+#else
+    #define EZML_PHASE(stats, owner, phase) ((void)0)
+    #define EZML_TRACE_SCOPE(...) ((void)0)
+    #define EZML_BYTES(stats, phase, bytes) ((void)0)
+    #define EZML_ITER(stats, derivative_norm) ((void)0)
+    #define EZML_RESET_ITERS(stats) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * @file trace.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief Trace and TraceScope class declarations
+ * @version 0.1
+ * @date 2024-06-08
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Trace is written in Chrome trace-event JSON format, which can be opened in `chrome://tracing` or https://ui.perfetto.dev.
+ * Events are recorded only if the library is built with `-DEZML_STATS`: phases of models, solvers and transformers
+ * (fit, every solver iteration, transform, predict), and work of every thread in parallel parts.
+ */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <chrono>
+#include <string>
+
+/**
+ * @brief Process-wide recorder of trace events.
+ *
+ * Recording is thread-safe, every event is tagged with id of thread that recorded it.
+ */
+class Trace
+{
+    public:
+
+        /**
+         * @brief Clock of events.
+         *
+         */
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Start recording events, forget events of previous recording.
+         *
+         * @param path Path to trace file, written by `stop()`
+         */
+        static void start(const std::string& path);
+
+        /**
+         * @brief Stop recording and write events to trace file. Throws `DataFileException`, if file cannot be written.
+         *
+         */
+        static void stop();
+
+        /**
+         * @brief Check, if events are being recorded.
+         *
+         * @return true, if recording
+         * @return false, if not
+         */
+        static bool is_enabled();
+
+        /**
+         * @brief Record complete event (span of time) of calling thread, if recording.
+         *
+         * @param owner Name of object the event belongs to, empty for none
+         * @param name Name of event
+         * @param begin Start time of event
+         * @param end End time of event
+         */
+        static void record(const std::string& owner, const char* name, const Clock::time_point begin, const Clock::time_point end);
+
+        /**
+         * @brief Get id of calling thread: small number, assigned once per thread in order of its first event.
+         *
+         * @return size_t
+         */
+        static size_t get_thread_id();
+};
+
+/**
+ * @brief Span of trace: records event between its construction and destruction, used in parallel parts.
+ *
+ */
+class TraceScope
+{
+    public:
+
+        /**
+         * @brief Construct a new TraceScope object and start span.
+         *
+         * @param name Name of event
+         */
+        explicit TraceScope(const char* name);
+
+        /**
+         * @brief Construct a new TraceScope object and start span of object's phase.
+         *
+         * @param owner Name of object the event belongs to, must outlive the span
+         * @param name Name of event
+         */
+        TraceScope(const std::string& owner, const char* name);
+
+        /**
+         * @brief Destroy the TraceScope object and record span.
+         *
+         */
+        ~TraceScope();
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+
+        /**
+         * @brief Name of object the event belongs to, null for none.
+         *
+         */
+        const std::string* owner_;
+
+        /**
+         * @brief Name of event.
+         *
+         */
+        const char* name_;
+
+        /**
+         * @brief Start time, if recording.
+         *
+         */
+        Trace::Clock::time_point begin_;
+
+        /**
+         * @brief Recording flag at construction.
+         *
+         */
+        bool enabled_;
+
+};
+
+#endif
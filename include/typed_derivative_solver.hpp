@@ -0,0 +1,365 @@
+/**
+ * @file typed_derivative_solver.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief TypedDerivativeSolver class declarations
+ * @version 0.1
+ * @date 2024-05-29
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef TYPED_DERIVATIVE_SOLVER_HPP
+#define TYPED_DERIVATIVE_SOLVER_HPP
+
+#include <functional>
+#include <string>
+#include "types.hpp"
+#include "base_solver.hpp"
+#include "block_source.hpp"
+#include "diff_loss_functions.hpp"
+
+using namespace Types;
+
+/**
+ * @brief Derivative Solver class template parameterized on derivative of loss function. Inherits from `BaseSolver` class.
+ * 
+ * Loss is a functor type known at compile time, so calling it costs no indirection 
+ * and its predict and derivative expressions are inlined into optimization loop.
+ * 
+ * In parallel mode, derivative of row-separable loss is computed on cache-sized blocks of rows, one block per thread at a time,
+ * and partial derivatives are summed in a fixed tree order, so the result is bitwise reproducible for any number of threads
+ * and does not rely on BLAS-internal threading.
+ * 
+ * Optionally, weights are scored on validation data every few iterations, optimization stops when the score has not improved 
+ * for a number of evaluations, and the best weights seen are returned. Solver state can be checkpointed to disk every few iterations, 
+ * so interrupted optimization resumes from the last checkpoint instead of the first iteration.
+ * Progress of every iteration is passed to callback, which can stop optimization; with verbose flag and no callback, it is printed.
+ * 
+ * Members are compiled into the library and explicitly instantiated for the functor types below only, so any other functor type 
+ * fails to link. Custom derivative of loss is passed at runtime through `DiffLoss::DynamicLoss` (i.e. with `DerivativeSolver`).
+ * 
+ * @tparam LossType functor type of derivative of loss function: `DiffLoss::MeanSquaredErrorLossGrad`, `DiffLoss::MeanSquaredErrorLossNewton`, 
+ * `DiffLoss::LogLikelihoodLossGrad`, `DiffLoss::LogLikelihoodLossNewton`, `DiffLoss::CrossEntropyLossGrad`, `DiffLoss::DynamicLoss`
+ */
+template <typename LossType>
+class TypedDerivativeSolver : public BaseSolver
+{
+    public:
+        
+        /**
+         * @brief Construct a new Typed Derivative Solver object with stateless loss functor.
+         * 
+         * @param learning_rate Learning rate
+         * @param max_iter Max number of optimization iterations
+         * @param min_derivative_size Min size of the vector of derivative
+         * @param verbose Show solver's steps flag
+         * @param parallel Reduce derivative over blocks of rows on all threads flag
+         */
+        TypedDerivativeSolver(const double learning_rate, 
+                              const size_t max_iter, 
+                              const double min_derivative_size, 
+                              const bool verbose=false,
+                              const bool parallel=false);
+
+        /**
+         * @brief Construct a new Typed Derivative Solver object with given loss functor.
+         * 
+         * @param diff_loss Functor of derivative of loss function
+         * @param learning_rate Learning rate
+         * @param max_iter Max number of optimization iterations
+         * @param min_derivative_size Min size of the vector of derivative
+         * @param verbose Show solver's steps flag
+         * @param parallel Reduce derivative over blocks of rows on all threads flag
+         */
+        TypedDerivativeSolver(const LossType& diff_loss,
+                              const double learning_rate, 
+                              const size_t max_iter, 
+                              const double min_derivative_size, 
+                              const bool verbose=false,
+                              const bool parallel=false);
+        
+        /**
+         * @brief Set validation-based early stopping, used by `optimize()` with validation data.
+         * 
+         * Configure solver before passing it to a model, since the model keeps its own copy.
+         * 
+         * @param predict_func Prediction function, i.e. `Predict::linreg` or `Predict::logreg_proba`
+         * @param metric_func Validation metric, i.e. `Metrics::mse`
+         * @param eval_every Score weights on validation data every `eval_every` iterations
+         * @param patience Stop after `patience` evaluations without improvement
+         * @param greater_is_better Maximize (i.e. `Metrics::r2`) instead of minimize (i.e. `Metrics::mse`) metric
+         * @return TypedDerivativeSolver& 
+         */
+        TypedDerivativeSolver& set_early_stopping(const std::function<Target(const Features&, const Weights&)>& predict_func,
+                                                  const std::function<double(const Target&, const Target&)>& metric_func,
+                                                  const size_t eval_every,
+                                                  const size_t patience,
+                                                  const bool greater_is_better=false);
+
+        /**
+         * @brief Set checkpointing of solver state (iteration, weights, early stopping state) to disk.
+         * 
+         * If checkpoint file exists when optimization starts, optimization resumes from it. 
+         * The file is replaced atomically every `checkpoint_every` iterations and removed when optimization is complete.
+         * Checkpoint records number of rows, loss, learning rate and max number of iterations; 
+         * optimization throws `DataFileException` instead of resuming checkpoint of other data or settings.
+         * 
+         * @param path Path to checkpoint file
+         * @param checkpoint_every Save state every `checkpoint_every` iterations
+         * @return TypedDerivativeSolver& 
+         */
+        TypedDerivativeSolver& set_checkpoint(const std::string& path, const size_t checkpoint_every);
+
+        /**
+         * @brief Set callback called after every iteration with its progress, i.e. to export convergence telemetry or to stop on custom criterion.
+         * 
+         * Training loss is computed for callback only if both prediction and loss functions are given, 
+         * which costs one more pass over data per iteration. On block sources, it is mean of blocks' losses weighted by their sizes.
+         * 
+         * @param callback Callback, returns true to stop optimization
+         * @param predict_func Prediction function, i.e. `Predict::linreg` or `Predict::logreg_proba`
+         * @param loss_func Loss function of target and prediction, i.e. `Metrics::mse`
+         * @return TypedDerivativeSolver& 
+         */
+        TypedDerivativeSolver& set_callback(const IterationCallback& callback,
+                                            const std::function<Target(const Features&, const Weights&)>& predict_func={},
+                                            const std::function<double(const Target&, const Target&)>& loss_func={});
+
+        /**
+         * @brief Return learned weights by using gradient descent.
+         * 
+         * @param w Row vector of weights
+         * @param X Matrix of feature variables
+         * @param y Column vector of target variable
+         * @return Weights 
+         */
+        const Weights optimize(Weights& w, const Features& X, const Target& y);
+
+        /**
+         * @brief Return best weights on validation data learned by using gradient descent with early stopping.
+         * 
+         * @param w Row vector of weights
+         * @param X Matrix of feature variables
+         * @param y Column vector of target variable
+         * @param X_val Matrix of validation feature variables, with dummy feature as in `X`
+         * @param y_val Column vector of validation target variable
+         * @return Weights 
+         */
+        const Weights optimize(Weights& w, const Features& X, const Target& y, const Features& X_val, const Target& y_val);
+
+        /**
+         * @brief Return learned weights by using gradient descent on data streamed in blocks.
+         * 
+         * Every iteration makes one pass over blocks. For row-separable losses, derivative is the scaled sum of blocks' partial derivatives, 
+         * which equals full-data derivative. Newton steps are ratios of sums, so they are not separable: the step is approximated 
+         * by the row-weighted mean of blocks' steps. Any other derivative is the sum of blocks' derivatives, 
+         * which equals full-data derivative for losses summed over observations, as gradients of the library are.
+         * 
+         * @param w Row vector of weights
+         * @param source Source of blocks of data
+         * @return Weights 
+         */
+        const Weights optimize(Weights& w, const BlockSource& source);
+
+        /**
+         * @brief Compute derivative of loss function.
+         * 
+         * @param w Row vector of weights
+         * @param X Matrix of feature variables
+         * @param y Column vector of target variable
+         * @return Derivative
+         */
+        const Derivative compute_derivative(const Weights& w, const Features& X, const Target& y);
+
+        /**
+         * @brief Get best validation score of last optimization, worst possible (infinite) if not evaluated.
+         * 
+         * @return const double 
+         */
+        const double get_best_score() const;
+
+        /**
+         * @brief Get iteration of best validation score of last optimization.
+         * 
+         * @return const size_t 
+         */
+        const size_t get_best_iter() const;
+
+    private:
+
+        /**
+         * @brief Run gradient descent loop with all stopping criteria, checkpointing and resuming.
+         * 
+         * @tparam DerivativeFunc Type of function computing derivative at given weights
+         * @tparam LossFunc Type of function computing training loss at given weights
+         * @param w Row vector of weights
+         * @param num_rows Number of rows of training data, recorded in checkpoint
+         * @param derivative Function computing derivative at given weights
+         * @param loss Function computing training loss at given weights, called only for callback
+         * @param X_val Matrix of validation feature variables, no validation if null
+         * @param y_val Column vector of validation target variable, no validation if null
+         * @return const Weights 
+         */
+        template <typename DerivativeFunc, typename LossFunc>
+        const Weights descend_(Weights& w, const size_t num_rows, DerivativeFunc&& derivative, LossFunc&& loss, const Features* X_val, const Target* y_val);
+
+        /**
+         * @brief Save solver state to checkpoint file.
+         * 
+         * @param next_iter Iteration to resume from
+         * @param w Row vector of current weights
+         * @param fingerprint Fingerprint of data and solver settings
+         */
+        void save_checkpoint_(const size_t next_iter, const Weights& w, const std::string& fingerprint) const;
+
+        /**
+         * @brief Load solver state from checkpoint file, if it exists.
+         * 
+         * @param w Row vector of weights to overwrite with checkpointed ones
+         * @param fingerprint Fingerprint of data and solver settings, must match the checkpointed one
+         * @return const size_t Iteration to resume from, 0 if there is no checkpoint
+         */
+        const size_t load_checkpoint_(Weights& w, const std::string& fingerprint);
+
+        /**
+         * @brief Get fingerprint of checkpointed optimization: solver and loss type, number of rows, learning rate and max number of iterations.
+         * 
+         * @param num_rows Number of rows of training data
+         * @return const std::string 
+         */
+        const std::string fingerprint_(const size_t num_rows) const;
+
+        /**
+         * @brief Sum partial derivatives of row-separable loss, over cache-sized blocks of rows in parallel mode.
+         * 
+         * @param w Row vector of weights
+         * @param X Matrix of feature variables
+         * @param y_true Column vector of target variable
+         * @return const Derivative 
+         */
+        const Derivative sum_partials_(const Weights& w, const Features& X, const Target& y_true) const;
+
+        /**
+         * @brief Derivative of loss function used for computing optimization step.
+         * 
+         */
+        const LossType diff_loss_;
+        
+        /**
+         * @brief Learning rate.
+         * 
+         */
+        const double learning_rate_;
+        
+        /**
+         * @brief Max number of optimization iterations.
+         * 
+         */
+        const size_t max_iter_;
+        
+        /**
+         * @brief Min size of the vector of derivative.
+         * 
+         */
+        const double min_derivative_size_;
+
+        /**
+         * @brief Reduce derivative over blocks of rows on all threads flag.
+         * 
+         */
+        const bool parallel_;
+
+        /**
+         * @brief Prediction function for validation.
+         * 
+         */
+        std::function<Target(const Features&, const Weights&)> predict_func_;
+
+        /**
+         * @brief Validation metric.
+         * 
+         */
+        std::function<double(const Target&, const Target&)> metric_func_;
+
+        /**
+         * @brief Callback called after every iteration.
+         * 
+         */
+        IterationCallback callback_;
+
+        /**
+         * @brief Prediction function for training loss reported to callback.
+         * 
+         */
+        std::function<Target(const Features&, const Weights&)> loss_predict_func_;
+
+        /**
+         * @brief Training loss reported to callback.
+         * 
+         */
+        std::function<double(const Target&, const Target&)> loss_func_;
+
+        /**
+         * @brief Score weights on validation data every `eval_every_` iterations.
+         * 
+         */
+        size_t eval_every_;
+
+        /**
+         * @brief Max number of evaluations without improvement.
+         * 
+         */
+        size_t patience_;
+
+        /**
+         * @brief Maximize instead of minimize validation metric flag.
+         * 
+         */
+        bool greater_is_better_;
+
+        /**
+         * @brief Path to checkpoint file, no checkpointing if empty.
+         * 
+         */
+        std::string checkpoint_path_;
+
+        /**
+         * @brief Save state every `checkpoint_every_` iterations.
+         * 
+         */
+        size_t checkpoint_every_;
+
+        /**
+         * @brief Best weights on validation data.
+         * 
+         */
+        Weights best_weights_;
+
+        /**
+         * @brief Best validation score.
+         * 
+         */
+        double best_score_;
+
+        /**
+         * @brief Validation has been evaluated at least once flag.
+         * 
+         */
+        bool has_best_;
+
+        /**
+         * @brief Iteration of best validation score.
+         * 
+         */
+        size_t best_iter_;
+
+        /**
+         * @brief Number of evaluations without improvement since the best one.
+         * 
+         */
+        size_t num_bad_evals_;
+
+};
+
+#endif
@@ -12,6 +12,9 @@
 #ifndef TYPES_HPP
 #define TYPES_HPP
 
+#include <cstdint>
+#include <functional>
+#include <string>
 #include <boost/type_index.hpp>
 #include <armadillo>
 
@@ -27,16 +30,140 @@ namespace Types
     */
     using Target = arma::dvec;
 
+    /**
+     * Matrix of predicted class probabilities, one column per class (doubles).
+    */
+    using Probabilities = arma::dmat;
+
+    /**
+     * Column vector of time series process (doubles).
+    */
+    using TimeSeries = arma::dvec;
+
+    /**
+     * Column vector of quantile levels in [0, 1] (doubles).
+    */
+    using QuantileLevels = arma::dvec;
+
+    /**
+     * @brief Pair of mean forecasted path and matrix of quantile bands (one column per level) -- forecast distribution.
+     * 
+     */
+    using ForecastBands = std::pair<const TimeSeries, const Features>;
+
+    /**
+     * Row vector of information criterion values for orders 1 ... p (doubles).
+    */
+    using Criteria = arma::drowvec;
+
+    /**
+     * @brief Pair of row vectors of AIC and BIC values for orders 1 ... p -- order selection.
+     * 
+     */
+    using InfoCriteria = std::pair<const Criteria, const Criteria>;
+
+    /**
+     * @brief Information criterion to select model's order with.
+     * 
+     */
+    enum class Criterion
+    {
+        AIC, ///< Akaike information criterion
+        BIC  ///< Bayesian information criterion
+    };
+
+    /**
+     * @brief Link between linear predictor and target of synthetic data.
+     * 
+     */
+    enum class Link : std::uint8_t
+    {
+        IDENTITY, ///< Linear regression target: linear predictor plus Gaussian noise
+        LOGIT     ///< Logistic regression target: class 1 with probability of logistic function of linear predictor
+    };
+
+    /**
+     * @brief Storage type of column in columnar dataset file.
+     * 
+     */
+    enum class ColumnType : std::uint8_t
+    {
+        FLOAT64, ///< 8-byte double, can be viewed in place without decoding
+        FLOAT32  ///< 4-byte float, half the size, widened to double on load
+    };
+
+    /**
+     * @brief Compression of column in columnar dataset file.
+     * 
+     */
+    enum class Compression : std::uint8_t
+    {
+        NONE,        ///< Raw values, can be viewed in place without decoding (if `ColumnType::FLOAT64`)
+        SHUFFLE_RLE  ///< Bytes of values grouped by significance, then run-length encoded
+    };
+
+    /**
+     * @brief Schema of one column in columnar dataset file: name, storage type, compression.
+     * 
+     */
+    struct ColumnSchema
+    {
+        std::string name;                             ///< Column's name (up to 47 characters are stored)
+        ColumnType type = ColumnType::FLOAT64;        ///< Storage type
+        Compression compression = Compression::NONE;  ///< Compression
+    };
+
     /**
      * Row vector of model's weights (doubles).
     */
     using Weights = arma::drowvec;
 
+    /**
+     * Matrix of multinomial model's weights, one column per class (doubles).
+    */
+    using ClassWeights = arma::dmat;
+
+    /**
+     * Matrix of many models' weights, one row per model (doubles).
+    */
+    using BatchWeights = arma::dmat;
+
+    /**
+     * Column vector of many models' sigmas (standard deviations), one per model (doubles).
+    */
+    using Sigmas = arma::dvec;
+
+    /**
+     * Column vector of regularization strengths (doubles).
+    */
+    using Lambdas = arma::dvec;
+
     /**
      * Row vector of n-th order derivative of loss function (doubles).
     */
     using Derivative = arma::drowvec;
 
+    /**
+     * @brief Progress of one iteration of derivative-based optimization, passed to solver's callback.
+     * 
+     */
+    struct IterationInfo
+    {
+        size_t iter;             ///< Index of iteration, starting from 0
+        double loss;             ///< Training loss at weights before the step, 0 if loss is not set
+        bool has_loss;           ///< Training loss is computed flag
+        double derivative_norm;  ///< 2-norm of derivative
+        double step_size;        ///< 2-norm of the step (learning rate times derivative norm), 0 if converged
+        double elapsed;          ///< Wall time since start of optimization, s
+        const Weights& weights;  ///< Weights after the step
+    };
+
+    /**
+     * @brief Callback called by derivative-based solver after every iteration, returns true to stop optimization.
+     * 
+     */
+    using IterationCallback = std::function<bool(const IterationInfo&)>;
+
     /**
      * Confusion Matrix (doubles).
     */
@@ -69,6 +196,12 @@ namespace Types
      */
     using ROCCurve = std::pair<const Recalls, const Fallouts>;
 
+    /**
+     * @brief Pair of row vectors of MSE and \f$ R^2 \f$ scores, one per fold -- cross-validation scores.
+     * 
+     */
+    using CVScores = std::pair<const arma::drowvec, const arma::drowvec>;
+
     /**
      * Row vector of true positives computed for different thresholds (unsigned int).
     */
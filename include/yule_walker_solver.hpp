@@ -0,0 +1,126 @@
+/**
+ * @file yule_walker_solver.hpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief YuleWalkerSolver class declarations
+ * @version 0.1
+ * @date 2024-05-02
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef YULE_WALKER_SOLVER_HPP
+#define YULE_WALKER_SOLVER_HPP
+
+#include "types.hpp"
+#include "base_solver.hpp"
+
+using namespace Types;
+
+/**
+ * @brief Yule-Walker (Levinson-Durbin) solver class for Autoregressive AR(p) model. Inherits from `BaseSolver` class.
+ * 
+ * Works directly on time series, i.e. lag matrix is not needed.
+ */
+class YuleWalkerSolver : public BaseSolver
+{
+    public:
+        
+        /**
+         * @brief Construct a new Yule-Walker Solver object.
+         * 
+         * https://en.wikipedia.org/wiki/Autoregressive_model#Yule%E2%80%93Walker_equations
+         * 
+         */
+        YuleWalkerSolver();
+        
+        /**
+         * @brief Return weights of AR(p) model (intercept first) by solving Yule-Walker equations.
+         * 
+         * Autocovariances are computed in one pass, or via FFT when p is large. 
+         * Toeplitz system is solved with Levinson-Durbin recursion in \f$ O(p^2) \f$.
+         * Throws `ConstantSeriesException`, if time series is constant.
+         * 
+         * @param process Time series vector
+         * @param p Order of lag
+         * @return Weights 
+         */
+        const Weights optimize(const TimeSeries& process, const size_t p);
+
+        /**
+         * @brief Return weights of AR(p) model (intercept first) of best order \f$ p \le p_{max} \f$.
+         * 
+         * All orders \f$ 1 \ldots p_{max} \f$ are fitted in one Levinson-Durbin sweep, 
+         * i.e. at the cost of a single AR(\f$ p_{max} \f$) fit, and scored with information criteria:
+         * 
+         * \f$ AIC(k) = n \ln \sigma^2_{k} + 2 (k + 1) \f$,
+         * 
+         * \f$ BIC(k) = n \ln \sigma^2_{k} + (k + 1) \ln n \f$,
+         * 
+         * where \f$ \sigma^2_{k} \f$ is the white noise variance of AR(k) model, 
+         * \f$ n \f$ is the length of time series. Order 1 is returned, if no higher order scores better.
+         * Throws `ConstantSeriesException`, if time series is constant.
+         * 
+         * @param process Time series vector
+         * @param max_p Max order of lag
+         * @param criterion Information criterion to minimize
+         * @return Weights 
+         */
+        const Weights select_order(const TimeSeries& process, const size_t max_p, const Criterion criterion);
+
+        /**
+         * @brief Get standard deviation of white noise (innovations) of last solved model.
+         * 
+         * @return const double 
+         */
+        const double get_sigma() const;
+
+        /**
+         * @brief Compute autocovariances \f$ \gamma_0 \ldots \gamma_{p} \f$ of time series.
+         * 
+         * @param process Time series vector
+         * @param p Max lag
+         * @return const TimeSeries 
+         */
+        static const TimeSeries autocovariances(const TimeSeries& process, const size_t p);
+
+        /**
+         * @brief Get AIC and BIC of every order \f$ 1 \ldots p \f$ scored during last solve.
+         * 
+         * @return const InfoCriteria 
+         */
+        const InfoCriteria get_criteria() const;
+
+    private:
+
+        /**
+         * @brief Run Levinson-Durbin recursion up to order `max_p`, scoring every order.
+         * 
+         * @param process Time series vector
+         * @param max_p Max order of lag
+         * @param select Return best order by `criterion` flag, otherwise return order `max_p`
+         * @param criterion Information criterion to minimize
+         * @return Weights 
+         */
+        const Weights solve_(const TimeSeries& process, const size_t max_p, const bool select, const Criterion criterion);
+
+        /**
+         * @brief Standard deviation of white noise (innovations) of last solved model.
+         * 
+         */
+        double sigma_;
+
+        /**
+         * @brief AIC of every order scored during last solve.
+         * 
+         */
+        Criteria aic_;
+
+        /**
+         * @brief BIC of every order scored during last solve.
+         * 
+         */
+        Criteria bic_;
+};
+
+#endif
@@ -0,0 +1,178 @@
+/**
+ * @file autoreg_batch.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief AutoRegBatch class implementation
+ * @version 0.1
+ * @date 2024-05-06
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <armadillo>
+#include "autoreg_batch.hpp"
+#include "exceptions.hpp"
+#include "stats.hpp"
+
+AutoRegBatch::AutoRegBatch(const size_t p)
+: p_(p)
+, weights_()
+, sigmas_()
+, fitted_(false)
+{
+    // Init batch here
+    // Set batch's name as string representation of its type
+    name_ = Types::get_name(*this);
+}
+
+AutoRegBatch& AutoRegBatch::fit(const Features& processes)
+{
+    // Throw if p is too small or too large
+    if (p_ < 1 || p_ >= processes.n_rows)
+        throw WrongOrderException();
+
+    const size_t num_series = processes.n_cols;
+    weights_.set_size(num_series, p_ + 1);
+    sigmas_.set_size(num_series);
+    #pragma omp parallel
+    {
+        // Scratch memory is allocated once per thread
+        std::vector<double> gram((p_ + 1) * (p_ + 2));
+        // One span per thread, since series are too many and too small to be traced one by one
+        EZML_TRACE_SCOPE(name_, "fit_series");
+        #pragma omp for schedule(dynamic, 64)
+        for (size_t series = 0; series < num_series; ++series)
+            fit_series_(processes.colptr(series), processes.n_rows, series, gram);
+    }
+    // Models are fitted now
+    fitted_ = true;
+    // Return object for possible cascading in pipelines
+    return *this;
+}
+
+AutoRegBatch& AutoRegBatch::fit(const std::vector<TimeSeries>& processes)
+{
+    // Throw if p is too small or too large for any series
+    for (const TimeSeries& process : processes)
+        if (p_ < 1 || p_ >= process.n_rows)
+            throw WrongOrderException();
+
+    const size_t num_series = processes.size();
+    weights_.set_size(num_series, p_ + 1);
+    sigmas_.set_size(num_series);
+    #pragma omp parallel
+    {
+        // Scratch memory is allocated once per thread
+        std::vector<double> gram((p_ + 1) * (p_ + 2));
+        // One span per thread, since series are too many and too small to be traced one by one
+        EZML_TRACE_SCOPE(name_, "fit_series");
+        #pragma omp for schedule(dynamic, 64)
+        for (size_t series = 0; series < num_series; ++series)
+            fit_series_(processes[series].memptr(), processes[series].n_rows, series, gram);
+    }
+    // Models are fitted now
+    fitted_ = true;
+    // Return object for possible cascading in pipelines
+    return *this;
+}
+
+void AutoRegBatch::fit_series_(const double* process, const size_t n, const size_t series, std::vector<double>& gram)
+{
+    // Augmented Gram matrix [X^T X | X^T y] of lag matrix with intercept, stored row-major, upper triangle only
+    // Row of lag matrix at time t is (1, X_{t-1}, ..., X_{t-p})
+    const size_t d = p_ + 1;
+    const size_t stride = d + 1;
+    std::fill(gram.begin(), gram.end(), 0.0);
+    double y_sum = 0.0;
+    for (size_t t = p_; t < n; ++t)
+    {
+        const double y = process[t];
+        y_sum += y;
+        for (size_t i = 0; i < d; ++i)
+        {
+            const double x_i = (i == 0) ? 1.0 : process[t - i];
+            double* gram_row = gram.data() + i * stride;
+            for (size_t j = i; j < d; ++j)
+                gram_row[j] += x_i * ((j == 0) ? 1.0 : process[t - j]);
+            gram_row[d] += x_i * y;
+        }
+    }
+
+    // Cholesky decomposition X^T X = R^T R in place, R is upper triangular
+    bool singular = false;
+    for (size_t j = 0; j < d && !singular; ++j)
+    {
+        double diag = gram[j * stride + j];
+        for (size_t k = 0; k < j; ++k)
+            diag -= gram[k * stride + j] * gram[k * stride + j];
+        if (!(diag > 0.0))
+        {
+            singular = true;
+            break;
+        }
+        diag = std::sqrt(diag);
+        gram[j * stride + j] = diag;
+        for (size_t i = j + 1; i < d; ++i)
+        {
+            double value = gram[j * stride + i];
+            for (size_t k = 0; k < j; ++k)
+                value -= gram[k * stride + j] * gram[k * stride + i];
+            gram[j * stride + i] = value / diag;
+        }
+    }
+
+    if (singular)
+    {
+        weights_.row(series).fill(arma::datum::nan);
+    }
+    else
+    {
+        // Forward substitution: R^T z = X^T y
+        for (size_t j = 0; j < d; ++j)
+        {
+            double value = gram[j * stride + d];
+            for (size_t k = 0; k < j; ++k)
+                value -= gram[k * stride + j] * gram[k * stride + d];
+            gram[j * stride + d] = value / gram[j * stride + j];
+        }
+        // Back substitution: R w = z
+        for (size_t i = d; i-- > 0;)
+        {
+            double value = gram[i * stride + d];
+            for (size_t k = i + 1; k < d; ++k)
+                value -= gram[i * stride + k] * gram[k * stride + d];
+            gram[i * stride + d] = value / gram[i * stride + i];
+            weights_.at(series, i) = gram[i * stride + d];
+        }
+    }
+
+    // Sigma is the standard deviation of target, same as `AutoRegModel`
+    const size_t n_obs = n - p_;
+    const double y_mean = y_sum / n_obs;
+    double y_ss = 0.0;
+    for (size_t t = p_; t < n; ++t)
+        y_ss += (process[t] - y_mean) * (process[t] - y_mean);
+    sigmas_[series] = (n_obs > 1) ? std::sqrt(y_ss / (n_obs - 1)) : 0.0;
+}
+
+const BatchWeights& AutoRegBatch::get_weights() const
+{
+    return weights_;
+}
+
+const Sigmas& AutoRegBatch::get_sigmas() const
+{
+    return sigmas_;
+}
+
+const bool AutoRegBatch::is_fitted() const
+{
+    return fitted_;
+}
+
+const std::string AutoRegBatch::get_name() const
+{
+    return name_;
+}
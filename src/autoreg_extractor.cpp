@@ -27,13 +27,14 @@ const Features AutoRegExtractor::extract_X(TimeSeries& process)
     if (p_ < 1 || p_ >= process.n_rows)
         throw WrongOrderException();
 
-    // Extract features
-    Features X = process.head(process.n_rows - p_);
-    
-    for (size_t order = 1; order < p_; ++order)
-    {    
-        X.insert_cols(0, process.rows(order, process.n_rows - p_ + order - 1));
-        
+    // Extract features into preallocated (n - p) x p lag (Hankel) matrix
+    // Column j holds lag j + 1, i.e. X_{t-1}, ..., X_{t-p}
+    const size_t n_obs = process.n_rows - p_;
+    Features X(n_obs, p_, arma::fill::none);
+    for (size_t lag = 0; lag < p_; ++lag)
+    {
+        const size_t first = p_ - 1 - lag;
+        X.col(lag) = process.rows(first, first + n_obs - 1);
     }
     
     return X;
@@ -45,8 +46,8 @@ const Target AutoRegExtractor::extract_y(TimeSeries& process)
     if (p_ < 1 || p_ >= process.n_rows)
        throw WrongOrderException();
 
-    // Extract target
-    return process.tail(process.n_rows - p_);
+    // Extract target as a view over process memory, i.e. without copying
+    return Target(process.memptr() + p_, process.n_rows - p_, false, true);
 }
 
 const std::string AutoRegExtractor::get_name() const
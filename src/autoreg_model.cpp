@@ -9,6 +9,7 @@
  * 
  */
 
+#include <vector>
 #include <armadillo>
 #include <boost/random.hpp>
 #include "autoreg_model.hpp"
@@ -18,6 +19,10 @@
 #include "ols_solver.hpp"
 #include "qr_solver.hpp"
 #include "derivative_solver.hpp"
+#include "typed_derivative_solver.hpp"
+#include "ridge_solver.hpp"
+#include "elastic_net_solver.hpp"
+#include "yule_walker_solver.hpp"
 
 template <typename SolverType>
 AutoRegModel<SolverType>::AutoRegModel(const SolverType& solver)
@@ -32,11 +37,17 @@ AutoRegModel<SolverType>::AutoRegModel(const SolverType& solver)
 }
 
 template <typename SolverType>
-const Weights AutoRegModel<SolverType>::get_weights() const
+const Weights& AutoRegModel<SolverType>::get_weights() const
 {
     return weights_;
 }
 
+template <typename SolverType>
+const SolverType& AutoRegModel<SolverType>::get_solver() const
+{
+    return solver_;
+}
+
 template <typename SolverType>
 const double AutoRegModel<SolverType>::get_sigma() const
 {
@@ -50,19 +61,28 @@ const size_t AutoRegModel<SolverType>::get_order() const
 }
 
 template <typename SolverType>
-const AutoRegModel<SolverType> AutoRegModel<SolverType>::fit(Features& X, const Target& y)
+AutoRegModel<SolverType>& AutoRegModel<SolverType>::fit(Features& X, const Target& y)
 {
 
+    EZML_PHASE(stats_, name_, "fit");
     // 1. Set model's order p
     p_ = X.n_cols;
     // 2. By default, intercept weight (w_0) is learned, so add dummy feature for it
-    Features dummy_feature = Features(X.n_rows, 1, arma::fill::ones);
-    //std::cout << dummy_feature;
-    X.insert_cols(0, dummy_feature);
-    // 3. Init weights with Gaussian noise N(0, 1)
-    weights_ = Weights(X.n_cols, arma::fill::randn);
+    {
+        EZML_PHASE(stats_, name_, "add_intercept");
+        // Dummy feature, then copy of features one column wider
+        EZML_BYTES(stats_, "add_intercept", X.n_rows * (X.n_cols + 2) * sizeof(double));
+        Features dummy_feature = Features(X.n_rows, 1, arma::fill::ones);
+        //std::cout << dummy_feature;
+        X.insert_cols(0, dummy_feature);
+    }
+    // 3. Init weights: warm start from given or current weights, or Gaussian noise N(0, 1)
+    weights_ = init_weights_(weights_, X.n_cols);
     // 4. Learn weights with solver
-    weights_ = solver_.optimize(weights_, X, y);
+    {
+        EZML_PHASE(stats_, name_, "optimize");
+        weights_ = solver_.optimize(weights_, X, y);
+    }
     // 5. Learn sigma
     sigma_ = arma::stddev(y);
     // 6. Model is fitted now
@@ -71,63 +91,257 @@ const AutoRegModel<SolverType> AutoRegModel<SolverType>::fit(Features& X, const
     return *this;
 }
 
+template <typename SolverType>
+AutoRegModel<SolverType>& AutoRegModel<SolverType>::fit(const TimeSeries& process, const size_t p)
+{
+    EZML_PHASE(stats_, name_, "fit");
+    // 1. Set model's order p
+    p_ = p;
+    // 2. Learn weights (intercept first) with solver
+    {
+        EZML_PHASE(stats_, name_, "optimize");
+        weights_ = solver_.optimize(process, p);
+    }
+    // 3. Learn sigma of white noise
+    sigma_ = solver_.get_sigma();
+    // 4. Model is fitted now
+    mark_as_fitted_();
+    // Return object for possible cascading in pipelines
+    return *this;
+}
+
+template <typename SolverType>
+const InfoCriteria AutoRegModel<SolverType>::select_order(const TimeSeries& process, const size_t max_p, const Criterion criterion)
+{
+    EZML_PHASE(stats_, name_, "select_order");
+    // 1. Learn weights (intercept first) of best order with solver
+    weights_ = solver_.select_order(process, max_p, criterion);
+    // 2. Set model's order p
+    p_ = weights_.n_cols - 1;
+    // 3. Learn sigma of white noise
+    sigma_ = solver_.get_sigma();
+    // 4. Model is fitted now
+    mark_as_fitted_();
+    // Return criteria of every order
+    return solver_.get_criteria();
+}
+
 template <typename SolverType>
 const TimeSeries AutoRegModel<SolverType>::predict(const Features& X, const size_t num_periods) const
+{
+    // Randomize noise on every method call
+    return predict(X, num_periods, time(0));
+}
+
+template <typename SolverType>
+const TimeSeries AutoRegModel<SolverType>::predict(const Features& X, const size_t num_periods, const unsigned int seed) const
+{
+    TimeSeries forecast;
+    predict_into(X, num_periods, seed, forecast);
+    return forecast;
+}
+
+template <typename SolverType>
+void AutoRegModel<SolverType>::predict_into(const Features& X, const size_t num_periods, const unsigned int seed, TimeSeries& out) const
 {
     // Throw if not fitted yet
     if (!is_fitted())
         throw NotFittedException(get_name());
+    // Throw if features do not match model's order
+    if (X.n_cols != p_ + 1)
+        throw LagsShapeException(p_);
 
-    Features X_roll = X.tail_rows(1);
-    //X_roll.print("\nX_new:");
+    EZML_TRACE_SCOPE(name_, "predict");
     // Simulate AR process
-    TimeSeries forecast;
-    // Create random number generator, randomizing it on every method call
-    boost::mt19937 rng(time(0));
+    out.set_size(num_periods);
+    // Create random number generator, seeded explicitly
+    boost::mt19937 rng(seed);
+    simulate_path_(X, num_periods, rng, out.memptr());
+}
+
+template <typename SolverType>
+const TimeSeries AutoRegModel<SolverType>::forecast(const TimeSeries& process, const size_t num_periods, const unsigned int seed) const
+{
+    // Throw if not fitted yet
+    if (!is_fitted())
+        throw NotFittedException(get_name());
+    // Throw if time series is too short
+    if (process.n_rows < p_)
+        throw WrongOrderException();
+
+    // One row of features: dummy feature, then X_t, ..., X_{t-p+1}, so the first forecast period is t + 1
+    Features X(1, p_ + 1);
+    X(0, 0) = 1.0;
+    for (size_t lag = 0; lag < p_; ++lag)
+        X(0, lag + 1) = process[process.n_rows - 1 - lag];
+    return predict(X, num_periods, seed);
+}
+
+template <typename SolverType>
+const ForecastBands AutoRegModel<SolverType>::simulate(const Features& X, 
+                                                      const size_t num_periods, 
+                                                      const size_t num_paths, 
+                                                      const unsigned int seed, 
+                                                      const QuantileLevels& levels) const
+{
+    // Throw if not fitted yet
+    if (!is_fitted())
+        throw NotFittedException(get_name());
+    // Throw if features do not match model's order
+    if (X.n_cols != p_ + 1)
+        throw LagsShapeException(p_);
+    // Throw if there is nothing to simulate, since quantiles of no paths are undefined
+    if (num_periods == 0 || num_paths == 0)
+        throw WrongPathsException();
+
+    EZML_TRACE_SCOPE(name_, "simulate");
+    // Every path (column) is simulated independently
+    Features paths(num_periods, num_paths, arma::fill::none);
+    #pragma omp parallel for schedule(static)
+    for (size_t path = 0; path < num_paths; ++path)
+    {
+        EZML_TRACE_SCOPE(name_, "simulate_path");
+        // Each path has its own random number stream derived from (seed, path),
+        // so results are reproducible regardless of number of threads
+        boost::random::seed_seq seq{seed, static_cast<unsigned int>(path)};
+        boost::mt19937 rng(seq);
+        simulate_path_(X, num_periods, rng, paths.colptr(path));
+    }
+
+    // Mean path and quantile bands across paths for every period
+    const TimeSeries mean_path = arma::mean(paths, 1);
+    const Features bands = arma::quantile(paths, levels, 1);
+    return ForecastBands(mean_path, bands);
+}
+
+template <typename SolverType>
+void AutoRegModel<SolverType>::simulate_path_(const Features& X, const size_t num_periods, boost::mt19937& rng, double* forecast) const
+{
+    // Circular buffer of p latest values stored twice (at `i` and `i + p`),
+    // so that p latest values are always contiguous, newest first, starting at `head`
+    std::vector<double> lags(2 * p_);
+    size_t head = 0;
+    for (size_t lag = 0; lag < p_; ++lag)
+    {
+        // Skip intercept (dummy) feature in column 0
+        lags[lag] = lags[lag + p_] = X(X.n_rows - 1, lag + 1);
+    }
     // Gaussian (white) noise with zero mean and learned standard deviation
     boost::random::normal_distribution<> wn(0, sigma_);
     // Create generator for normal distribution
     // Every call of `sample()` will generate one random value from the distribution `noise`
     boost::variate_generator<boost::mt19937&, boost::normal_distribution<>> sample(rng, wn);
-    Target mu;
+    const double* w = weights_.memptr();
     for (size_t period = 0; period < num_periods; ++period)
     {
-        mu = Predict::linreg(X_roll, weights_); // Predict expected value
-        forecast.insert_rows(forecast.n_rows, mu + sample()); // Add white noise and populate forecast
-        X_roll.insert_cols(1, forecast.tail(1)); // Roll features
-        X_roll = X_roll.head_cols(p_ + 1); // by keeping only p latest + 1 (intercept) values
-        //X_roll.print("\nX_roll:");
+        // Predict expected value: w_0 + w_1 X_{t-1} + ... + w_p X_{t-p}
+        double mu = w[0];
+        const double* latest = lags.data() + head;
+        for (size_t lag = 0; lag < p_; ++lag)
+            mu += w[lag + 1] * latest[lag];
+        // Add white noise and populate forecast
+        forecast[period] = mu + sample();
+        // Roll features by overwriting the oldest value
+        head = (head + p_ - 1) % p_;
+        lags[head] = lags[head + p_] = forecast[period];
     }
-
-    return forecast;
 }
 
 // Explicitly instantiate templates for actual required types
 // BaseSolver
 template AutoRegModel<BaseSolver>::AutoRegModel(const BaseSolver&);
-template const Weights AutoRegModel<BaseSolver>::get_weights() const;
+template const Weights& AutoRegModel<BaseSolver>::get_weights() const;
+template const BaseSolver& AutoRegModel<BaseSolver>::get_solver() const;
 template const double AutoRegModel<BaseSolver>::get_sigma() const;
 template const size_t AutoRegModel<BaseSolver>::get_order() const;
-template const AutoRegModel<BaseSolver> AutoRegModel<BaseSolver>::fit(Features&, const Target&);
+template AutoRegModel<BaseSolver>& AutoRegModel<BaseSolver>::fit(Features&, const Target&);
 template const TimeSeries AutoRegModel<BaseSolver>::predict(const Features&, const size_t) const;
+template const TimeSeries AutoRegModel<BaseSolver>::predict(const Features&, const size_t, const unsigned int) const;
+template void AutoRegModel<BaseSolver>::predict_into(const Features&, const size_t, const unsigned int, TimeSeries&) const;
+template const TimeSeries AutoRegModel<BaseSolver>::forecast(const TimeSeries&, const size_t, const unsigned int) const;
+template const ForecastBands AutoRegModel<BaseSolver>::simulate(const Features&, const size_t, const size_t, const unsigned int, const QuantileLevels&) const;
 // OLSSolver
 template AutoRegModel<OLSSolver>::AutoRegModel(const OLSSolver&);
-template const Weights AutoRegModel<OLSSolver>::get_weights() const;
+template const Weights& AutoRegModel<OLSSolver>::get_weights() const;
+template const OLSSolver& AutoRegModel<OLSSolver>::get_solver() const;
 template const double AutoRegModel<OLSSolver>::get_sigma() const;
 template const size_t AutoRegModel<OLSSolver>::get_order() const;
-template const AutoRegModel<OLSSolver> AutoRegModel<OLSSolver>::fit(Features&, const Target&);
+template AutoRegModel<OLSSolver>& AutoRegModel<OLSSolver>::fit(Features&, const Target&);
 template const TimeSeries AutoRegModel<OLSSolver>::predict(const Features&, const size_t) const;
+template const TimeSeries AutoRegModel<OLSSolver>::predict(const Features&, const size_t, const unsigned int) const;
+template void AutoRegModel<OLSSolver>::predict_into(const Features&, const size_t, const unsigned int, TimeSeries&) const;
+template const TimeSeries AutoRegModel<OLSSolver>::forecast(const TimeSeries&, const size_t, const unsigned int) const;
+template const ForecastBands AutoRegModel<OLSSolver>::simulate(const Features&, const size_t, const size_t, const unsigned int, const QuantileLevels&) const;
 // QRSolver
 template AutoRegModel<QRSolver>::AutoRegModel(const QRSolver&);
-template const Weights AutoRegModel<QRSolver>::get_weights() const;
+template const Weights& AutoRegModel<QRSolver>::get_weights() const;
+template const QRSolver& AutoRegModel<QRSolver>::get_solver() const;
 template const double AutoRegModel<QRSolver>::get_sigma() const;
 template const size_t AutoRegModel<QRSolver>::get_order() const;
-template const AutoRegModel<QRSolver> AutoRegModel<QRSolver>::fit(Features&, const Target&);
+template AutoRegModel<QRSolver>& AutoRegModel<QRSolver>::fit(Features&, const Target&);
 template const TimeSeries AutoRegModel<QRSolver>::predict(const Features&, const size_t) const;
+template const TimeSeries AutoRegModel<QRSolver>::predict(const Features&, const size_t, const unsigned int) const;
+template void AutoRegModel<QRSolver>::predict_into(const Features&, const size_t, const unsigned int, TimeSeries&) const;
+template const TimeSeries AutoRegModel<QRSolver>::forecast(const TimeSeries&, const size_t, const unsigned int) const;
+template const ForecastBands AutoRegModel<QRSolver>::simulate(const Features&, const size_t, const size_t, const unsigned int, const QuantileLevels&) const;
 // DerivativeSolver
 template AutoRegModel<DerivativeSolver>::AutoRegModel(const DerivativeSolver&);
-template const Weights AutoRegModel<DerivativeSolver>::get_weights() const;
+template const Weights& AutoRegModel<DerivativeSolver>::get_weights() const;
+template const DerivativeSolver& AutoRegModel<DerivativeSolver>::get_solver() const;
 template const double AutoRegModel<DerivativeSolver>::get_sigma() const;
 template const size_t AutoRegModel<DerivativeSolver>::get_order() const;
-template const AutoRegModel<DerivativeSolver> AutoRegModel<DerivativeSolver>::fit(Features&, const Target&);
+template AutoRegModel<DerivativeSolver>& AutoRegModel<DerivativeSolver>::fit(Features&, const Target&);
 template const TimeSeries AutoRegModel<DerivativeSolver>::predict(const Features&, const size_t) const;
+template const TimeSeries AutoRegModel<DerivativeSolver>::predict(const Features&, const size_t, const unsigned int) const;
+template void AutoRegModel<DerivativeSolver>::predict_into(const Features&, const size_t, const unsigned int, TimeSeries&) const;
+template const TimeSeries AutoRegModel<DerivativeSolver>::forecast(const TimeSeries&, const size_t, const unsigned int) const;
+template const ForecastBands AutoRegModel<DerivativeSolver>::simulate(const Features&, const size_t, const size_t, const unsigned int, const QuantileLevels&) const;
+// TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>
+template AutoRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::AutoRegModel(const TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>&);
+template const Weights& AutoRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::get_weights() const;
+template const TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>& AutoRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::get_solver() const;
+template const double AutoRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::get_sigma() const;
+template const size_t AutoRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::get_order() const;
+template AutoRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>& AutoRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::fit(Features&, const Target&);
+template const TimeSeries AutoRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::predict(const Features&, const size_t) const;
+template const TimeSeries AutoRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::predict(const Features&, const size_t, const unsigned int) const;
+template void AutoRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::predict_into(const Features&, const size_t, const unsigned int, TimeSeries&) const;
+template const TimeSeries AutoRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::forecast(const TimeSeries&, const size_t, const unsigned int) const;
+template const ForecastBands AutoRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::simulate(const Features&, const size_t, const size_t, const unsigned int, const QuantileLevels&) const;
+// YuleWalkerSolver
+template AutoRegModel<YuleWalkerSolver>::AutoRegModel(const YuleWalkerSolver&);
+template const Weights& AutoRegModel<YuleWalkerSolver>::get_weights() const;
+template const YuleWalkerSolver& AutoRegModel<YuleWalkerSolver>::get_solver() const;
+template const double AutoRegModel<YuleWalkerSolver>::get_sigma() const;
+template const size_t AutoRegModel<YuleWalkerSolver>::get_order() const;
+template AutoRegModel<YuleWalkerSolver>& AutoRegModel<YuleWalkerSolver>::fit(const TimeSeries&, const size_t);
+template const InfoCriteria AutoRegModel<YuleWalkerSolver>::select_order(const TimeSeries&, const size_t, const Criterion);
+template const TimeSeries AutoRegModel<YuleWalkerSolver>::predict(const Features&, const size_t) const;
+template const TimeSeries AutoRegModel<YuleWalkerSolver>::predict(const Features&, const size_t, const unsigned int) const;
+template void AutoRegModel<YuleWalkerSolver>::predict_into(const Features&, const size_t, const unsigned int, TimeSeries&) const;
+template const TimeSeries AutoRegModel<YuleWalkerSolver>::forecast(const TimeSeries&, const size_t, const unsigned int) const;
+template const ForecastBands AutoRegModel<YuleWalkerSolver>::simulate(const Features&, const size_t, const size_t, const unsigned int, const QuantileLevels&) const;
+// RidgeSolver
+template AutoRegModel<RidgeSolver>::AutoRegModel(const RidgeSolver&);
+template const Weights& AutoRegModel<RidgeSolver>::get_weights() const;
+template const RidgeSolver& AutoRegModel<RidgeSolver>::get_solver() const;
+template const double AutoRegModel<RidgeSolver>::get_sigma() const;
+template const size_t AutoRegModel<RidgeSolver>::get_order() const;
+template AutoRegModel<RidgeSolver>& AutoRegModel<RidgeSolver>::fit(Features&, const Target&);
+template const TimeSeries AutoRegModel<RidgeSolver>::predict(const Features&, const size_t) const;
+template const TimeSeries AutoRegModel<RidgeSolver>::predict(const Features&, const size_t, const unsigned int) const;
+template void AutoRegModel<RidgeSolver>::predict_into(const Features&, const size_t, const unsigned int, TimeSeries&) const;
+template const TimeSeries AutoRegModel<RidgeSolver>::forecast(const TimeSeries&, const size_t, const unsigned int) const;
+template const ForecastBands AutoRegModel<RidgeSolver>::simulate(const Features&, const size_t, const size_t, const unsigned int, const QuantileLevels&) const;
+// ElasticNetSolver
+template AutoRegModel<ElasticNetSolver>::AutoRegModel(const ElasticNetSolver&);
+template const Weights& AutoRegModel<ElasticNetSolver>::get_weights() const;
+template const ElasticNetSolver& AutoRegModel<ElasticNetSolver>::get_solver() const;
+template const double AutoRegModel<ElasticNetSolver>::get_sigma() const;
+template const size_t AutoRegModel<ElasticNetSolver>::get_order() const;
+template AutoRegModel<ElasticNetSolver>& AutoRegModel<ElasticNetSolver>::fit(Features&, const Target&);
+template const TimeSeries AutoRegModel<ElasticNetSolver>::predict(const Features&, const size_t) const;
+template const TimeSeries AutoRegModel<ElasticNetSolver>::predict(const Features&, const size_t, const unsigned int) const;
+template void AutoRegModel<ElasticNetSolver>::predict_into(const Features&, const size_t, const unsigned int, TimeSeries&) const;
+template const TimeSeries AutoRegModel<ElasticNetSolver>::forecast(const TimeSeries&, const size_t, const unsigned int) const;
+template const ForecastBands AutoRegModel<ElasticNetSolver>::simulate(const Features&, const size_t, const size_t, const unsigned int, const QuantileLevels&) const;
@@ -10,11 +10,15 @@
  */
 
 #include <armadillo>
+#include <boost/random.hpp>
 #include "base_model.hpp"
 #include "exceptions.hpp"
 
 BaseModel::BaseModel()
 : fitted_(false)
+, warm_start_(false)
+, seeded_(false)
+, seed_(0)
 {
     // Init model here
     // Set model's name as string representation of its type
@@ -33,7 +37,7 @@ void BaseModel::mark_as_fitted_()
     fitted_ = true;
 }
 
-const BaseModel BaseModel::fit(const Features& X, const Target& y)
+BaseModel& BaseModel::fit(const Features& X, const Target& y)
 {
     // BaseModel knows nothing about how to fit
     // So, basically learn the mean value of target variable
@@ -55,7 +59,68 @@ const Target BaseModel::predict(const Features& X) const
     return y_mean_;
 }
 
+void BaseModel::predict_into(const Features& X, Target& out) const
+{
+    // Throw if not fitted yet
+    if (!is_fitted())
+        throw NotFittedException(get_name());
+
+    // Learned mean value of target variable for every observation
+    out.set_size(X.n_rows);
+    out.fill(y_mean_.is_empty() ? 0.0 : y_mean_[0]);
+}
+
 const std::string BaseModel::get_name() const
 {
     return name_;
+}
+
+const Stats& BaseModel::get_stats() const
+{
+    return stats_;
+}
+
+void BaseModel::set_warm_start(const bool warm_start)
+{
+    warm_start_ = warm_start;
+}
+
+void BaseModel::set_initial_weights(const Weights& w)
+{
+    initial_weights_ = w;
+}
+
+void BaseModel::set_seed(const unsigned int seed)
+{
+    seeded_ = true;
+    seed_ = seed;
+}
+
+const Weights BaseModel::init_weights_(const Weights& current, const size_t num_weights)
+{
+    EZML_PHASE(stats_, name_, "init_weights");
+    // 1. Given initial weights, used once
+    if (!initial_weights_.is_empty())
+    {
+        // Throw if shape does not match
+        if (initial_weights_.n_cols != num_weights)
+            throw WeightsShapeException();
+        const Weights w = initial_weights_;
+        initial_weights_.reset();
+        return w;
+    }
+    // 2. Warm start from current weights of fitted model
+    if (warm_start_ && is_fitted() && current.n_cols == num_weights)
+        return current;
+    // 3. Cold start with Gaussian noise N(0, 1)
+    EZML_BYTES(stats_, "init_weights", num_weights * sizeof(double));
+    if (!seeded_)
+        return Weights(num_weights, arma::fill::randn);
+    // Seeded noise comes from local engine, so it neither depends on nor changes global random state
+    boost::mt19937 rng(seed_);
+    boost::random::normal_distribution<> normal;
+    Weights w(num_weights);
+    for (double& weight : w)
+        weight = normal(rng);
+    return w;
 }
\ No newline at end of file
@@ -33,3 +33,8 @@ const std::string BaseSolver::get_name() const
 {
     return name_;
 }
+
+const Stats& BaseSolver::get_stats() const
+{
+    return stats_;
+}
@@ -33,7 +33,7 @@ void BaseTransformer::mark_as_fitted_()
     fitted_ = true;
 }
 
-BaseTransformer BaseTransformer::fit(Features& X)
+BaseTransformer& BaseTransformer::fit(Features& X)
 {
     // BaseTransformer knows nothing about how to fit
     // So, basically do nothing
@@ -54,12 +54,38 @@ const Features BaseTransformer::transform(Features& X)
     return X;
 }
 
+void BaseTransformer::transform_into(const Features& X, Features& out) const
+{
+    // Throw if not fitted yet
+    if (!is_fitted())
+        throw NotFittedException(get_name());
+
+    // BaseTransformer does not change features
+    out = X;
+}
+
 const Features BaseTransformer::fit_transform(Features& X)
 {
     return fit(X).transform(X);
 }
 
+const ClassWeights BaseTransformer::fold(const ClassWeights& W) const
+{
+    // Throw if not fitted yet
+    if (!is_fitted())
+        throw NotFittedException(get_name());
+
+    // BaseTransformer does not change features
+    // So, basically return original weights back
+    return W;
+}
+
 const std::string BaseTransformer::get_name() const
 {
     return name_;
 }
+
+const Stats& BaseTransformer::get_stats() const
+{
+    return stats_;
+}
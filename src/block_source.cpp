@@ -0,0 +1,95 @@
+/**
+ * @file block_source.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief BlockSource class implementation
+ * @version 0.1
+ * @date 2024-05-29
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <algorithm>
+#include <armadillo>
+#include "block_source.hpp"
+#include "exceptions.hpp"
+
+BlockSource::BlockSource(const size_t num_rows, const size_t num_features, const size_t block_rows, const Generator& generator)
+: num_rows_(num_rows)
+, num_features_(num_features)
+, block_rows_(std::max<size_t>(block_rows, 1))
+, generator_(generator)
+{
+    // Init source here
+    // Set source's name as string representation of its type
+    name_ = Types::get_name(*this);
+}
+
+BlockSource::BlockSource(const ColumnarDataset& dataset, const size_t block_rows)
+: BlockSource(dataset.get_num_rows(), dataset.get_num_features(), block_rows,
+              // Dataset is captured by copy, which shares its file
+              [dataset](const size_t first_row, Features& X, Target& y) { dataset.read_rows(first_row, X, y); })
+{
+}
+
+void BlockSource::read(const size_t block, Features& X, Target& y) const
+{
+    // Throw if block is out of range, since its row range would underflow
+    if (block >= get_num_blocks())
+        throw WrongBlockException(block, get_num_blocks());
+
+    const size_t first_row = block * block_rows_;
+    const size_t rows = std::min(block_rows_, num_rows_ - first_row);
+    X.set_size(rows, num_features_ + 1);
+    y.set_size(rows);
+    // Intercept (dummy) feature
+    X.col(0).ones();
+    // Generator writes the rest of columns in place through a view
+    Features X_block(X.colptr(1), rows, num_features_, false, true);
+    generator_(first_row, X_block, y);
+}
+
+void BlockSource::accumulate(Target& means, Features& scatter) const
+{
+    const size_t d = num_features_;
+    means.zeros(d + 1);
+    scatter.zeros(d + 1, d + 1);
+    size_t n = 0;
+    Features X;
+    Target y;
+    for (size_t block = 0; block < get_num_blocks(); ++block)
+    {
+        read(block, X, y);
+        // Block's own means and centered scatter of (x_1, ..., x_d, y)
+        Features Z = arma::join_rows(X.tail_cols(d), y);
+        const Target block_means = arma::mean(Z, 0).t();
+        Z.each_row() -= block_means.t();
+        const size_t block_n = Z.n_rows;
+        // Merge block into running statistics
+        const Target delta = block_means - means;
+        const double total = static_cast<double>(n + block_n);
+        scatter += Z.t() * Z + (static_cast<double>(n) * block_n / total) * (delta * delta.t());
+        means += delta * (block_n / total);
+        n += block_n;
+    }
+}
+
+size_t BlockSource::get_num_rows() const
+{
+    return num_rows_;
+}
+
+size_t BlockSource::get_num_features() const
+{
+    return num_features_;
+}
+
+size_t BlockSource::get_num_blocks() const
+{
+    return (num_rows_ + block_rows_ - 1) / block_rows_;
+}
+
+const std::string BlockSource::get_name() const
+{
+    return name_;
+}
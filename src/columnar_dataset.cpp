@@ -0,0 +1,491 @@
+/**
+ * @file columnar_dataset.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief ColumnarDataset class implementation
+ * @version 0.1
+ * @date 2024-05-27
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <armadillo>
+#include "columnar_dataset.hpp"
+#include "block_source.hpp"
+#include "exceptions.hpp"
+#include "stats.hpp"
+
+namespace
+{
+    // File layout (native byte order):
+    // FileHeader | ColumnHeader x num_cols | padding to page | column 0 | padding to 8 bytes | column 1 | ...
+    // Feature columns come first, target column is the last one
+    const char MAGIC[8] = {'E', 'Z', 'M', 'L', 'C', 'O', 'L', '\0'};
+    const std::uint32_t VERSION = 1;
+    const size_t DATA_ALIGNMENT = 4096;
+    const size_t COLUMN_ALIGNMENT = 8;
+
+    struct FileHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t num_cols;
+        std::uint64_t num_rows;
+    };
+
+    struct ColumnHeader
+    {
+        char name[48];
+        std::uint8_t type;
+        std::uint8_t compression;
+        std::uint8_t reserved[6];
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    size_t align(const size_t offset, const size_t alignment)
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    size_t type_size(const ColumnType type)
+    {
+        return type == ColumnType::FLOAT32 ? sizeof(float) : sizeof(double);
+    }
+
+    // Store doubles with column's type
+    void narrow(const double* values, const size_t n, const ColumnType type, std::vector<std::uint8_t>& bytes)
+    {
+        bytes.resize(n * type_size(type));
+        if (type == ColumnType::FLOAT32)
+            for (size_t i = 0; i < n; ++i)
+            {
+                const float value = static_cast<float>(values[i]);
+                std::memcpy(bytes.data() + i * sizeof(float), &value, sizeof(float));
+            }
+        else
+            std::memcpy(bytes.data(), values, n * sizeof(double));
+    }
+
+    // Load doubles from column's type
+    void widen(const std::uint8_t* bytes, const size_t n, const ColumnType type, double* values)
+    {
+        if (type == ColumnType::FLOAT32)
+            for (size_t i = 0; i < n; ++i)
+            {
+                float value;
+                std::memcpy(&value, bytes + i * sizeof(float), sizeof(float));
+                values[i] = value;
+            }
+        else
+            std::memcpy(values, bytes, n * sizeof(double));
+    }
+
+    // Read exactly `size` bytes at `offset`, retrying short reads
+    bool read_exact(const int fd, void* buffer, size_t size, off_t offset)
+    {
+        char* out = static_cast<char*>(buffer);
+        while (size > 0)
+        {
+            const ssize_t got = ::pread(fd, out, size, offset);
+            if (got <= 0)
+                return false;
+            out += got;
+            size -= static_cast<size_t>(got);
+            offset += got;
+        }
+        return true;
+    }
+
+    // Write exactly `size` bytes at `offset`, retrying short writes
+    bool write_exact(const int fd, const void* buffer, size_t size, off_t offset)
+    {
+        const char* in = static_cast<const char*>(buffer);
+        while (size > 0)
+        {
+            const ssize_t put = ::pwrite(fd, in, size, offset);
+            if (put <= 0)
+                return false;
+            in += put;
+            size -= static_cast<size_t>(put);
+            offset += put;
+        }
+        return true;
+    }
+
+    // Shuffle + RLE: group k-th bytes of all values together (exponents, high and low mantissa bytes),
+    // so that repeated bytes of similar values form long runs, then run-length encode them (PackBits):
+    // control byte c < 128 is followed by c + 1 literal bytes, c > 128 is followed by one byte repeated 257 - c times
+    void shuffle_rle_encode(const std::vector<std::uint8_t>& bytes, const size_t elem_size, std::vector<std::uint8_t>& encoded)
+    {
+        const size_t n = bytes.size() / elem_size;
+        std::vector<std::uint8_t> planes(bytes.size());
+        for (size_t i = 0; i < n; ++i)
+            for (size_t b = 0; b < elem_size; ++b)
+                planes[b * n + i] = bytes[i * elem_size + b];
+
+        encoded.clear();
+        const size_t size = planes.size();
+        for (size_t i = 0; i < size; )
+        {
+            size_t run = 1;
+            while (i + run < size && run < 128 && planes[i + run] == planes[i])
+                ++run;
+            if (run >= 3)
+            {
+                encoded.push_back(static_cast<std::uint8_t>(257 - run));
+                encoded.push_back(planes[i]);
+                i += run;
+            }
+            else
+            {
+                // Literal bytes up to the next run of 3 or more
+                const size_t start = i;
+                size_t len = 0;
+                while (i < size && len < 128 && !(i + 2 < size && planes[i] == planes[i + 1] && planes[i] == planes[i + 2]))
+                {
+                    ++i;
+                    ++len;
+                }
+                encoded.push_back(static_cast<std::uint8_t>(len - 1));
+                encoded.insert(encoded.end(), planes.begin() + start, planes.begin() + start + len);
+            }
+        }
+    }
+
+    bool shuffle_rle_decode(const std::uint8_t* encoded, const size_t encoded_size, const size_t elem_size, std::vector<std::uint8_t>& bytes)
+    {
+        const size_t size = bytes.size();
+        std::vector<std::uint8_t> planes(size);
+        size_t out = 0;
+        const std::uint8_t* p = encoded;
+        const std::uint8_t* end = encoded + encoded_size;
+        while (p < end && out < size)
+        {
+            const std::uint8_t c = *p++;
+            if (c < 128)
+            {
+                const size_t len = c + 1;
+                if (static_cast<size_t>(end - p) < len || size - out < len)
+                    return false;
+                std::memcpy(planes.data() + out, p, len);
+                p += len;
+                out += len;
+            }
+            else if (c > 128)
+            {
+                const size_t len = 257 - c;
+                if (p == end || size - out < len)
+                    return false;
+                std::memset(planes.data() + out, *p++, len);
+                out += len;
+            }
+        }
+        if (out != size)
+            return false;
+
+        const size_t n = size / elem_size;
+        for (size_t i = 0; i < n; ++i)
+            for (size_t b = 0; b < elem_size; ++b)
+                bytes[i * elem_size + b] = planes[b * n + i];
+        return true;
+    }
+}
+
+ColumnarDataset::ColumnarDataset(const std::string& path)
+: file_(std::make_shared<MappedFile>(path, true /* writable, copy-on-write */))
+, path_(path)
+, num_rows_(0)
+{
+    // 1. Validate file header
+    const char* base = file_->begin();
+    const size_t file_size = file_->size();
+    FileHeader header;
+    if (file_size < sizeof(FileHeader))
+        throw DataFileException(path_, "is not a columnar dataset");
+    std::memcpy(&header, base, sizeof(FileHeader));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.num_cols == 0)
+        throw DataFileException(path_, "is not a columnar dataset");
+    if (file_size < sizeof(FileHeader) + header.num_cols * sizeof(ColumnHeader))
+        throw DataFileException(path_, "is truncated");
+    num_rows_ = header.num_rows;
+
+    // 2. Read and validate schema
+    for (size_t col = 0; col < header.num_cols; ++col)
+    {
+        ColumnHeader column;
+        std::memcpy(&column, base + sizeof(FileHeader) + col * sizeof(ColumnHeader), sizeof(ColumnHeader));
+        column.name[sizeof(column.name) - 1] = '\0';
+        if (column.type > static_cast<std::uint8_t>(ColumnType::FLOAT32) || column.compression > static_cast<std::uint8_t>(Compression::SHUFFLE_RLE))
+            throw DataFileException(path_, "has unknown column type or compression");
+        if (column.offset % COLUMN_ALIGNMENT != 0 || column.offset > file_size || column.size > file_size - column.offset)
+            throw DataFileException(path_, "is truncated");
+        const ColumnSchema schema{column.name, static_cast<ColumnType>(column.type), static_cast<Compression>(column.compression)};
+        if (schema.compression == Compression::NONE && column.size != num_rows_ * type_size(schema.type))
+            throw DataFileException(path_, "has column of wrong size");
+        schema_.push_back(schema);
+        offsets_.push_back(column.offset);
+        sizes_.push_back(column.size);
+    }
+    // Set dataset's name as string representation of its type
+    name_ = Types::get_name(*this);
+}
+
+void ColumnarDataset::write(const std::string& path, const Features& X, const Target& y, const std::vector<ColumnSchema>& schema /*={}*/)
+{
+    const size_t n = X.n_rows;
+    const size_t d = X.n_cols;
+    if (y.n_elem != n)
+        throw DataFileException(path, "cannot be written: target length does not match number of rows");
+    std::vector<ColumnSchema> columns(schema);
+    if (columns.empty())
+    {
+        for (size_t col = 0; col < d; ++col)
+            columns.push_back({"x" + std::to_string(col + 1)});
+        columns.push_back({"y"});
+    }
+    if (columns.size() != d + 1)
+        throw DataFileException(path, "cannot be written: schema must have one column per feature, then one for target");
+
+    // 1. Encode columns in parallel, raw doubles are written as is
+    std::vector<std::vector<std::uint8_t>> blobs(d + 1);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t col = 0; col <= d; ++col)
+    {
+        EZML_TRACE_SCOPE("encode_column");
+        const double* values = (col < d) ? X.colptr(col) : y.memptr();
+        const ColumnSchema& column = columns[col];
+        if (column.type == ColumnType::FLOAT64 && column.compression == Compression::NONE)
+            continue;
+        std::vector<std::uint8_t> bytes;
+        narrow(values, n, column.type, bytes);
+        if (column.compression == Compression::SHUFFLE_RLE)
+            shuffle_rle_encode(bytes, type_size(column.type), blobs[col]);
+        else
+            blobs[col].swap(bytes);
+    }
+
+    // 2. Lay out columns: data starts at page boundary, every column at 8-byte boundary
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.num_cols = static_cast<std::uint32_t>(d + 1);
+    header.num_rows = n;
+    std::vector<ColumnHeader> column_headers(d + 1);
+    size_t offset = align(sizeof(FileHeader) + (d + 1) * sizeof(ColumnHeader), DATA_ALIGNMENT);
+    for (size_t col = 0; col <= d; ++col)
+    {
+        ColumnHeader& column = column_headers[col];
+        column = ColumnHeader{};
+        std::strncpy(column.name, columns[col].name.c_str(), sizeof(column.name) - 1);
+        column.type = static_cast<std::uint8_t>(columns[col].type);
+        column.compression = static_cast<std::uint8_t>(columns[col].compression);
+        column.offset = offset;
+        column.size = (columns[col].type == ColumnType::FLOAT64 && columns[col].compression == Compression::NONE) ? n * sizeof(double) : blobs[col].size();
+        offset = align(offset + column.size, COLUMN_ALIGNMENT);
+    }
+
+    // 3. Write header, schema, then columns
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw DataFileException(path, "cannot be written");
+    out.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+    out.write(reinterpret_cast<const char*>(column_headers.data()), column_headers.size() * sizeof(ColumnHeader));
+    const std::vector<char> padding(DATA_ALIGNMENT, '\0');
+    size_t written = sizeof(FileHeader) + column_headers.size() * sizeof(ColumnHeader);
+    for (size_t col = 0; col <= d; ++col)
+    {
+        const ColumnHeader& column = column_headers[col];
+        out.write(padding.data(), column.offset - written);
+        if (blobs[col].empty() && column.size > 0)
+            out.write(reinterpret_cast<const char*>((col < d) ? X.colptr(col) : y.memptr()), column.size);
+        else
+            out.write(reinterpret_cast<const char*>(blobs[col].data()), column.size);
+        written = column.offset + column.size;
+    }
+    if (!out)
+        throw DataFileException(path, "cannot be written");
+}
+
+void ColumnarDataset::convert(const std::string& csv_path, const CSVLoader& loader, const std::string& path, const std::vector<ColumnSchema>& schema /*={}*/)
+{
+    Features X;
+    Target y;
+    loader.load(csv_path, X, y);
+    write(path, X, y, schema);
+}
+
+void ColumnarDataset::write(const std::string& path, const BlockSource& source)
+{
+    const size_t n = source.get_num_rows();
+    const size_t d = source.get_num_features();
+
+    // 1. Lay out raw double columns: data starts at page boundary, every column at 8-byte boundary
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.num_cols = static_cast<std::uint32_t>(d + 1);
+    header.num_rows = n;
+    std::vector<ColumnHeader> column_headers(d + 1);
+    size_t offset = align(sizeof(FileHeader) + (d + 1) * sizeof(ColumnHeader), DATA_ALIGNMENT);
+    for (size_t col = 0; col <= d; ++col)
+    {
+        ColumnHeader& column = column_headers[col];
+        column = ColumnHeader{};
+        const std::string name = (col < d) ? "x" + std::to_string(col + 1) : "y";
+        std::strncpy(column.name, name.c_str(), sizeof(column.name) - 1);
+        column.type = static_cast<std::uint8_t>(ColumnType::FLOAT64);
+        column.compression = static_cast<std::uint8_t>(Compression::NONE);
+        column.offset = offset;
+        column.size = n * sizeof(double);
+        offset = align(offset + column.size, COLUMN_ALIGNMENT);
+    }
+
+    // 2. Write header and schema, size file to its full length, so blocks can be written into their rows
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw DataFileException(path, "cannot be written");
+    bool ok = write_exact(fd, &header, sizeof(FileHeader), 0)
+           && write_exact(fd, column_headers.data(), column_headers.size() * sizeof(ColumnHeader), sizeof(FileHeader))
+           && ::ftruncate(fd, static_cast<off_t>(offset)) == 0;
+
+    // 3. Write every block into its rows of every column, skipping intercept (dummy) feature
+    Features X;
+    Target y;
+    size_t first_row = 0;
+    for (size_t block = 0; block < source.get_num_blocks() && ok; ++block)
+    {
+        source.read(block, X, y);
+        for (size_t col = 0; col <= d && ok; ++col)
+        {
+            const double* values = (col < d) ? X.colptr(col + 1) : y.memptr();
+            ok = write_exact(fd, values, y.n_elem * sizeof(double), static_cast<off_t>(column_headers[col].offset + first_row * sizeof(double)));
+        }
+        first_row += y.n_elem;
+    }
+    ok = (::close(fd) == 0) && ok;
+    if (!ok)
+        throw DataFileException(path, "cannot be written");
+}
+
+bool ColumnarDataset::is_raw_(const size_t col) const
+{
+    return schema_[col].type == ColumnType::FLOAT64 && schema_[col].compression == Compression::NONE;
+}
+
+void ColumnarDataset::decode_(const size_t col, double* out) const
+{
+    const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(file_->begin()) + offsets_[col];
+    const ColumnSchema& column = schema_[col];
+    if (column.compression == Compression::NONE)
+    {
+        widen(data, num_rows_, column.type, out);
+        return;
+    }
+    std::vector<std::uint8_t> bytes(num_rows_ * type_size(column.type));
+    if (!shuffle_rle_decode(data, sizes_[col], type_size(column.type), bytes))
+        throw DataFileException(path_, "has corrupted column " + column.name);
+    widen(bytes.data(), num_rows_, column.type, out);
+}
+
+void ColumnarDataset::read_rows(const size_t first_row, Features& X, Target& y) const
+{
+    const size_t d = get_num_features();
+    const size_t rows = y.n_elem;
+    if (first_row + rows > num_rows_ || X.n_rows != rows || X.n_cols != d)
+        throw DataFileException(path_, "has no rows " + std::to_string(first_row) + " ... " + std::to_string(first_row + rows));
+    for (size_t col = 0; col <= d; ++col)
+        if (schema_[col].compression != Compression::NONE)
+            throw DataFileException(path_, "has compressed column " + schema_[col].name + ", which cannot be read by rows");
+
+    const int fd = ::open(path_.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw DataFileException(path_, "cannot be opened");
+    std::vector<std::uint8_t> bytes;
+    bool ok = true;
+    for (size_t col = 0; col <= d && ok; ++col)
+    {
+        const size_t size = type_size(schema_[col].type);
+        const off_t offset = static_cast<off_t>(offsets_[col] + first_row * size);
+        double* out = (col < d) ? X.colptr(col) : y.memptr();
+        if (schema_[col].type == ColumnType::FLOAT64)
+            // Read doubles straight into output
+            ok = read_exact(fd, out, rows * size, offset);
+        else
+        {
+            bytes.resize(rows * size);
+            ok = read_exact(fd, bytes.data(), rows * size, offset);
+            widen(bytes.data(), rows, schema_[col].type, out);
+        }
+    }
+    ::close(fd);
+    if (!ok)
+        throw DataFileException(path_, "cannot be read");
+}
+
+const Features ColumnarDataset::get_features() const
+{
+    const size_t d = get_num_features();
+    // 1. View raw double columns in place, if they follow each other without gaps
+    bool contiguous = true;
+    for (size_t col = 0; col < d && contiguous; ++col)
+        contiguous = is_raw_(col) && offsets_[col] == offsets_[0] + col * num_rows_ * sizeof(double);
+    if (contiguous && d > 0 && num_rows_ > 0)
+        return Features(reinterpret_cast<double*>(file_->begin() + offsets_[0]), num_rows_, d, false, false);
+
+    // 2. Otherwise, decode columns in parallel
+    Features X(num_rows_, d);
+    bool corrupted = false;
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t col = 0; col < d; ++col)
+    {
+        EZML_TRACE_SCOPE(name_, "decode_column");
+        try
+        {
+            decode_(col, X.colptr(col));
+        }
+        catch (DataFileException&)
+        {
+            #pragma omp atomic write
+            corrupted = true;
+        }
+    }
+    if (corrupted)
+        throw DataFileException(path_, "has corrupted feature column");
+    return X;
+}
+
+const Target ColumnarDataset::get_target() const
+{
+    const size_t col = get_num_features();
+    if (is_raw_(col) && num_rows_ > 0)
+        return Target(reinterpret_cast<double*>(file_->begin() + offsets_[col]), num_rows_, false, false);
+
+    Target y(num_rows_);
+    decode_(col, y.memptr());
+    return y;
+}
+
+const std::vector<ColumnSchema> ColumnarDataset::get_schema() const
+{
+    return schema_;
+}
+
+size_t ColumnarDataset::get_num_rows() const
+{
+    return num_rows_;
+}
+
+size_t ColumnarDataset::get_num_features() const
+{
+    return schema_.size() - 1;
+}
+
+const std::string ColumnarDataset::get_name() const
+{
+    return name_;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file cross_validator.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief CrossValidator class implementation
+ * @version 0.1
+ * @date 2024-05-08
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <armadillo>
+#include "cross_validator.hpp"
+#include "exceptions.hpp"
+#include "metrics.hpp"
+#include "stats.hpp"
+
+CrossValidator::CrossValidator(const size_t num_folds, const double lambda /*=0.0*/)
+: num_folds_(num_folds)
+, lambda_(lambda)
+{
+    // Init cross-validator here
+    // Set cross-validator's name as string representation of its type
+    name_ = Types::get_name(*this);
+}
+
+void CrossValidator::gram_(const Features& X, const Target& y, Features& gram, Target& moment)
+{
+    const size_t d = X.n_cols;
+    gram.set_size(d + 1, d + 1);
+    moment.set_size(d + 1);
+    // Intercept block
+    gram(0, 0) = X.n_rows;
+    const Weights sums = arma::sum(X, 0);
+    gram.submat(0, 1, 0, d) = sums;
+    gram.submat(1, 0, d, 0) = sums.t();
+    // Features block
+    gram.submat(1, 1, d, d) = X.t() * X;
+    moment[0] = arma::sum(y);
+    moment.tail(d) = X.t() * y;
+}
+
+const CVScores CrossValidator::evaluate(const Features& X, const Target& y) const
+{
+    // Throw if number of folds is too small or too large
+    if (num_folds_ < 2 || num_folds_ > X.n_rows)
+        throw WrongFoldsException();
+
+    // 1. Gram matrix and moment of full data, computed once
+    Features gram;
+    Target moment;
+    gram_(X, y, gram, moment);
+
+    // 2. Evaluate every fold on its own rows
+    const size_t n = X.n_rows;
+    const size_t d = X.n_cols;
+    arma::drowvec mses(num_folds_);
+    arma::drowvec r2s(num_folds_);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t fold = 0; fold < num_folds_; ++fold)
+    {
+        EZML_TRACE_SCOPE(name_, "evaluate_fold");
+        const size_t first = fold * n / num_folds_;
+        const size_t last = (fold + 1) * n / num_folds_ - 1;
+        const Features X_fold = X.rows(first, last);
+        const Target y_fold = y.rows(first, last);
+        // Downdate: training data = full data minus fold
+        Features gram_fold;
+        Target moment_fold;
+        gram_(X_fold, y_fold, gram_fold, moment_fold);
+        Features gram_train = gram - gram_fold;
+        const Target moment_train = moment - moment_fold;
+        // Ridge penalty on all weights except intercept
+        for (size_t i = 1; i <= d; ++i)
+            gram_train(i, i) += lambda_;
+        // Exceptions must not escape parallel region, so singular system is reported by return value
+        Target w;
+        if (!arma::solve(w, gram_train, moment_train))
+        {
+            mses[fold] = arma::datum::nan;
+            r2s[fold] = arma::datum::nan;
+            continue;
+        }
+        // Score on fold
+        const Target y_pred = X_fold * w.tail(d) + w[0];
+        mses[fold] = Metrics::mse(y_fold, y_pred);
+        r2s[fold] = Metrics::r2(y_fold, y_pred);
+    }
+
+    return CVScores(mses, r2s);
+}
+
+const std::string CrossValidator::get_name() const
+{
+    return name_;
+}
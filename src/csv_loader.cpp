@@ -0,0 +1,214 @@
+/**
+ * @file csv_loader.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief CSVLoader class implementation
+ * @version 0.1
+ * @date 2024-05-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <omp.h>
+#include <armadillo>
+#include "csv_loader.hpp"
+#include "mapped_file.hpp"
+#include "exceptions.hpp"
+#include "stats.hpp"
+
+namespace
+{
+    // End of the line starting at `p`: position of line break, or `end`
+    const char* line_end(const char* p, const char* end)
+    {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        return nl ? nl : end;
+    }
+
+    // Start of the line following the one that ends at `stop`
+    const char* next_line(const char* stop, const char* end)
+    {
+        return stop < end ? stop + 1 : end;
+    }
+
+    // Line is empty, if it has nothing but line break
+    bool is_empty(const char* line, const char* stop)
+    {
+        return line == stop || (stop - line == 1 && *line == '\r');
+    }
+
+    // Parse one field as double, surrounding blanks and quotes are ignored, empty field is NaN
+    bool parse_field(const char* p, const char* e, double& value)
+    {
+        while (p < e && (*p == ' ' || *p == '\t' || *p == '"'))
+            ++p;
+        while (e > p && (e[-1] == ' ' || e[-1] == '\t' || e[-1] == '"' || e[-1] == '\r'))
+            --e;
+        if (p == e)
+        {
+            value = std::numeric_limits<double>::quiet_NaN();
+            return true;
+        }
+        if (*p == '+')
+            ++p;
+        const std::from_chars_result result = std::from_chars(p, e, value);
+        return result.ec == std::errc() && result.ptr == e;
+    }
+}
+
+CSVLoader::CSVLoader(const std::vector<size_t>& feature_cols, const size_t target_col, const size_t header_rows /*=1*/, const char delimiter /*=','*/)
+: feature_cols_(feature_cols)
+, target_col_(target_col)
+, header_rows_(header_rows)
+, delimiter_(delimiter)
+{
+    // Map every column to its output slot, so that each row is scanned once, left to right
+    // Slots 0 ... d - 1 are features, slot d is target
+    std::vector<size_t> cols(feature_cols_);
+    cols.push_back(target_col_);
+    size_t max_col = 0;
+    for (const size_t col : cols)
+        max_col = std::max(max_col, col);
+    slots_.assign(max_col + 1, -1);
+    for (size_t slot = 0; slot < cols.size(); ++slot)
+    {
+        if (slots_[cols[slot]] < 0)
+            slots_[cols[slot]] = static_cast<long>(slot);
+        else
+            // Column is selected more than once, copy it after parsing
+            copies_.emplace_back(slot, static_cast<size_t>(slots_[cols[slot]]));
+    }
+    // Set loader's name as string representation of its type
+    name_ = Types::get_name(*this);
+}
+
+size_t CSVLoader::count_rows_(const char* begin, const char* end)
+{
+    size_t num_rows = 0;
+    for (const char* line = begin; line < end; )
+    {
+        const char* stop = line_end(line, end);
+        if (!is_empty(line, stop))
+            ++num_rows;
+        line = next_line(stop, end);
+    }
+    return num_rows;
+}
+
+size_t CSVLoader::parse_rows_(const char* begin, const char* end, size_t row, Features& X, Target& y) const
+{
+    const size_t d = feature_cols_.size();
+    const size_t num_cols = slots_.size();
+    size_t num_parsed = 0;
+    for (const char* line = begin; line < end; )
+    {
+        const char* stop = line_end(line, end);
+        if (!is_empty(line, stop))
+        {
+            // Scan fields left to right up to the last selected column, the rest of line is skipped
+            const char* field = line;
+            size_t col = 0;
+            while (col < num_cols)
+            {
+                const char* delim = static_cast<const char*>(std::memchr(field, delimiter_, stop - field));
+                const char* field_end = delim ? delim : stop;
+                const long slot = slots_[col++];
+                if (slot >= 0)
+                {
+                    double value;
+                    if (!parse_field(field, field_end, value))
+                        return num_parsed;
+                    if (static_cast<size_t>(slot) < d)
+                        X.at(row, slot) = value;
+                    else
+                        y[row] = value;
+                }
+                if (!delim)
+                    break;
+                field = delim + 1;
+            }
+            // Row is too short
+            if (col < num_cols)
+                return num_parsed;
+            ++row;
+            ++num_parsed;
+        }
+        line = next_line(stop, end);
+    }
+    return num_parsed;
+}
+
+void CSVLoader::load(const std::string& path, Features& X, Target& y) const
+{
+    const size_t d = feature_cols_.size();
+    MappedFile file(path);
+    const char* begin = file.begin();
+    const char* end = file.end();
+
+    // 1. Skip UTF-8 byte order mark and header rows
+    if (end - begin >= 3 && std::memcmp(begin, "\xEF\xBB\xBF", 3) == 0)
+        begin += 3;
+    for (size_t h = 0; h < header_rows_ && begin < end; ++h)
+        begin = next_line(line_end(begin, end), end);
+
+    // 2. Split data into line-aligned chunks, several per thread to balance load
+    const size_t min_chunk_size = 1 << 16;
+    const size_t num_bytes = end - begin;
+    const size_t num_chunks = std::max<size_t>(1, std::min<size_t>(4 * omp_get_max_threads(), num_bytes / min_chunk_size));
+    std::vector<const char*> bounds(num_chunks + 1, end);
+    bounds[0] = begin;
+    for (size_t chunk = 1; chunk < num_chunks; ++chunk)
+    {
+        const char* p = std::max(begin + num_bytes * chunk / num_chunks, bounds[chunk - 1]);
+        // Move to the start of the next line, unless already there
+        if (p > begin && p < end && p[-1] != '\n')
+            p = next_line(line_end(p, end), end);
+        bounds[chunk] = p;
+    }
+
+    // 3. Count rows of every chunk to know where each chunk's rows go
+    std::vector<size_t> offsets(num_chunks + 1, 0);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+    {
+        EZML_TRACE_SCOPE(name_, "count_rows");
+        offsets[chunk + 1] = count_rows_(bounds[chunk], bounds[chunk + 1]);
+    }
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+        offsets[chunk + 1] += offsets[chunk];
+    const size_t n = offsets[num_chunks];
+
+    // 4. Parse chunks in parallel straight into outputs
+    X.set_size(n, d);
+    y.set_size(n);
+    std::vector<size_t> num_parsed(num_chunks, 0);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+    {
+        EZML_TRACE_SCOPE(name_, "parse_rows");
+        num_parsed[chunk] = parse_rows_(bounds[chunk], bounds[chunk + 1], offsets[chunk], X, y);
+    }
+    // Throw on first malformed row
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+        if (offsets[chunk] + num_parsed[chunk] < offsets[chunk + 1])
+            throw DataFileException(path, "has malformed data row " + std::to_string(offsets[chunk] + num_parsed[chunk] + 1));
+
+    // 5. Fill columns selected more than once
+    for (const auto& [slot, source] : copies_)
+    {
+        const Target column = (source < d) ? Target(X.col(source)) : y;
+        if (slot < d)
+            X.col(slot) = column;
+        else
+            y = column;
+    }
+}
+
+const std::string CSVLoader::get_name() const
+{
+    return name_;
+}
@@ -0,0 +1,261 @@
+/**
+ * @file data_generator.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief DataGenerator class implementation
+ * @version 0.1
+ * @date 2024-06-03
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <armadillo>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <boost/random.hpp>
+#include <boost/math/distributions/normal.hpp>
+#include "data_generator.hpp"
+#include "columnar_dataset.hpp"
+#include "stats.hpp"
+
+namespace
+{
+    // Key of innovations of autoregressive process, distinct from keys of rows
+    const std::uint64_t PROCESS_STREAM = 0xA5A5A5A5A5A5A5A5ULL;
+
+    // SplitMix64 finalizer: maps consecutive keys to uncorrelated 64-bit values
+    inline std::uint64_t mix(std::uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Counter-based random stream: state depends only on seed and counter (row or period), not on previous draws
+    class Stream
+    {
+        public:
+
+            Stream(const std::uint64_t seed, const std::uint64_t counter)
+            : state_(mix(mix(seed) + mix(counter + 1)))
+            {
+            }
+
+            // Uniform on (0, 1)
+            double uniform()
+            {
+                state_ += 0x9E3779B97F4A7C15ULL;
+                return (static_cast<double>(mix(state_) >> 11) + 0.5) * 0x1.0p-53;
+            }
+
+            // Standard normal by Box-Muller, draws are produced in pairs
+            double normal()
+            {
+                if (has_spare_)
+                {
+                    has_spare_ = false;
+                    return spare_;
+                }
+                const double radius = std::sqrt(-2.0 * std::log(uniform()));
+                const double angle = 2.0 * arma::datum::pi * uniform();
+                spare_ = radius * std::sin(angle);
+                has_spare_ = true;
+                return radius * std::cos(angle);
+            }
+
+            // Standard logistic by inversion
+            double logistic()
+            {
+                const double u = uniform();
+                return std::log(u / (1.0 - u));
+            }
+
+        private:
+
+            std::uint64_t state_;
+            double spare_ = 0.0;
+            bool has_spare_ = false;
+    };
+
+    // Indices of `count` of `size` elements, chosen uniformly without replacement (partial Fisher-Yates shuffle)
+    std::vector<size_t> choose(const size_t size, const size_t count, boost::mt19937& rng)
+    {
+        std::vector<size_t> indices(size);
+        std::iota(indices.begin(), indices.end(), 0);
+        for (size_t i = 0; i + 1 < size && i < count; ++i)
+        {
+            boost::random::uniform_int_distribution<size_t> pick(i, size - 1);
+            std::swap(indices[i], indices[pick(rng)]);
+        }
+        indices.resize(std::min(count, size));
+        return indices;
+    }
+}
+
+DataGenerator::DataGenerator(const size_t num_features, const unsigned int seed, const Link link/*=Link::IDENTITY*/,
+                             const double condition_number/*=1.0*/, const double sparsity/*=0.0*/, const double noise/*=1.0*/, const double balance/*=0.5*/)
+: num_features_(num_features)
+, seed_(seed)
+, link_(link)
+, noise_(noise)
+, mixing_()
+, weights_(num_features + 1)
+, process_weights_(num_features + 1)
+{
+    // Init generator here
+    const size_t d = num_features_;
+    const size_t num_zeros = static_cast<size_t>(std::round(std::clamp(sparsity, 0.0, 1.0) * d));
+    boost::mt19937 rng(seed_);
+    boost::random::normal_distribution<> normal;
+
+    // 1. Mixing matrix: random rotation, then geometric scales from 1 down to 1 / sqrt(condition number)
+    if (condition_number > 1.0 && d > 1)
+    {
+        Features G(d, d);
+        for (double& g : G)
+            g = normal(rng);
+        Features Q;
+        Features R;
+        arma::qr(Q, R, G);
+        Target scales(d);
+        for (size_t j = 0; j < d; ++j)
+            scales[j] = std::pow(condition_number, -0.5 * j / (d - 1));
+        mixing_ = arma::diagmat(scales) * Q.t();
+    }
+
+    // 2. True weights, some of them set to zero
+    for (double& w : weights_)
+        w = normal(rng);
+    for (const size_t j : choose(d, num_zeros, rng))
+        weights_[j + 1] = 0.0;
+    if (link_ == Link::LOGIT)
+    {
+        // Linear predictor without intercept is N(0, |M w|^2), logistic noise has variance pi^2 / 3,
+        // their sum is approximated by normal, so intercept shifts its `balance` quantile to zero
+        const Target w = weights_.tail(d).t();
+        const double variance = mixing_.is_empty() ? arma::dot(w, w) : std::pow(arma::norm(mixing_ * w), 2);
+        const double quantile = boost::math::quantile(boost::math::normal(), std::clamp(balance, 1e-9, 1.0 - 1e-9));
+        weights_[0] = std::sqrt(variance + arma::datum::pi * arma::datum::pi / 3.0) * quantile;
+    }
+
+    // 3. Autoregressive weights from partial autocorrelations by Levinson-Durbin recursion
+    const double radius = 1.0 - 1.0 / (1.0 + std::max(condition_number, 1.0));
+    boost::random::uniform_real_distribution<> pacf(-radius, radius);
+    Target alpha(d);
+    for (double& a : alpha)
+        a = pacf(rng);
+    for (const size_t k : choose(d, num_zeros, rng))
+        alpha[k] = 0.0;
+    Target phi(d, arma::fill::zeros);
+    for (size_t k = 0; k < d; ++k)
+    {
+        const Target previous = phi;
+        for (size_t j = 0; j < k; ++j)
+            phi[j] = previous[j] - alpha[k] * previous[k - 1 - j];
+        phi[k] = alpha[k];
+    }
+    process_weights_[0] = normal(rng);
+    if (d > 0)
+        process_weights_.tail(d) = phi.t();
+
+    // Set generator's name as string representation of its type
+    name_ = Types::get_name(*this);
+}
+
+void DataGenerator::fill(const size_t first_row, Features& X, Target& y) const
+{
+    const size_t n = X.n_rows;
+    const size_t d = num_features_;
+    const size_t num_chunks = (n + CHUNK_ROWS - 1) / CHUNK_ROWS;
+    const Target w = weights_.tail(d).t();
+    const double intercept = weights_[0];
+    #pragma omp parallel for schedule(static)
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+    {
+        EZML_TRACE_SCOPE(name_, "generate_chunk");
+        const size_t begin = chunk * CHUNK_ROWS;
+        const size_t rows = std::min(CHUNK_ROWS, n - begin);
+        // Independent features are drawn in place, correlated ones are drawn in chunk, then mixed by one matrix product
+        Features Z;
+        if (!mixing_.is_empty())
+            Z.set_size(rows, d);
+        Target noise(rows);
+        for (size_t row = 0; row < rows; ++row)
+        {
+            Stream stream(seed_, first_row + begin + row);
+            for (size_t j = 0; j < d; ++j)
+            {
+                if (mixing_.is_empty())
+                    X(begin + row, j) = stream.normal();
+                else
+                    Z(row, j) = stream.normal();
+            }
+            noise[row] = (link_ == Link::LOGIT) ? stream.logistic() : noise_ * stream.normal();
+        }
+        if (!mixing_.is_empty())
+            X.rows(begin, begin + rows - 1) = Z * mixing_;
+        // Target from linear predictor
+        const Target eta = X.rows(begin, begin + rows - 1) * w + intercept + noise;
+        if (link_ == Link::LOGIT)
+            y.subvec(begin, begin + rows - 1) = arma::conv_to<Target>::from(eta > 0.0);
+        else
+            y.subvec(begin, begin + rows - 1) = eta;
+    }
+}
+
+void DataGenerator::generate(const size_t num_rows, Features& X, Target& y) const
+{
+    X.set_size(num_rows, num_features_);
+    y.set_size(num_rows);
+    fill(0, X, y);
+}
+
+BlockSource::Generator DataGenerator::as_generator() const
+{
+    // Generator is captured by copy, which is small: weights and mixing matrix only
+    const DataGenerator generator(*this);
+    return [generator](const size_t first_row, Features& X, Target& y) { generator.fill(first_row, X, y); };
+}
+
+void DataGenerator::write(const std::string& path, const size_t num_rows, const size_t block_rows/*=1 << 16*/) const
+{
+    const BlockSource source(num_rows, num_features_, block_rows, as_generator());
+    ColumnarDataset::write(path, source);
+}
+
+TimeSeries DataGenerator::generate_process(const size_t length) const
+{
+    const size_t p = num_features_;
+    const size_t burn_in = 10 * p + 100;
+    const double* w = process_weights_.memptr();
+    // Start at process mean, so burn-in only has to forget initial values, not drift to mean
+    const double mean = w[0] / (1.0 - arma::accu(process_weights_.tail(p)));
+    TimeSeries process(burn_in + length);
+    // Innovations are drawn from one stream per period, recursion itself is sequential
+    for (size_t t = 0; t < process.n_elem; ++t)
+    {
+        Stream stream(seed_ ^ PROCESS_STREAM, t);
+        double value = w[0] + noise_ * stream.normal();
+        for (size_t lag = 1; lag <= p; ++lag)
+            value += w[lag] * ((t >= lag) ? process[t - lag] : mean);
+        process[t] = value;
+    }
+    return process.tail(length);
+}
+
+const Weights& DataGenerator::get_weights() const
+{
+    return weights_;
+}
+
+const Weights& DataGenerator::get_process_weights() const
+{
+    return process_weights_;
+}
+
+const std::string DataGenerator::get_name() const
+{
+    return name_;
+}
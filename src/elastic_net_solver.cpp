@@ -0,0 +1,151 @@
+/**
+ * @file elastic_net_solver.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief ElasticNetSolver class implementation
+ * @version 0.1
+ * @date 2024-05-15
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <armadillo>
+#include "elastic_net_solver.hpp"
+
+ElasticNetSolver::ElasticNetSolver(const Lambdas& lambdas, const double alpha /*=1.0*/, const double tol /*=1e-7*/, const size_t max_iter /*=1000*/)
+: lambdas_(lambdas)
+, alpha_(alpha)
+, tol_(tol)
+, max_iter_(max_iter)
+{
+    // Init solver here
+    // Set solver's name as string representation of its type
+    name_ = Types::get_name(*this);
+}
+
+const Weights ElasticNetSolver::optimize(Weights& w, const Features& X, const Target& y)
+{
+    const size_t n = X.n_rows;
+    const size_t d = X.n_cols - 1;
+    path_.set_size(lambdas_.n_rows, X.n_cols);
+    gcv_.set_size(lambdas_.n_rows);
+
+    EZML_PHASE(stats_, name_, "solve_path");
+    EZML_BYTES(stats_, "solve_path", X.n_rows * sizeof(double));
+    // 1. Center features (except intercept) and target, so that intercept is not penalized
+    // Features are a view over X without intercept column, centered implicitly: (X - 1 m)^T v = X^T v for any centered v
+    const Features X_features(const_cast<double*>(X.memptr()) + n, n, d, false, true);
+    const Weights x_means = arma::mean(X_features, 0);
+    const double y_mean = arma::mean(y);
+    const Target y_centered = y - y_mean;
+    const double sst = arma::dot(y_centered, y_centered);
+    const Target xty = X_features.t() * y_centered;
+    const Target col_sq = arma::var(X_features, 1, 0).t();
+
+    // 2. Covariance updates: correlations with residual c = X^T (y - X beta) / n are kept up to date, 
+    // when weight j changes by delta, c -= G_j delta / n, where column G_j is computed once, when feature j enters the model
+    Target corr = xty / n;
+    Target beta(d, arma::fill::zeros);
+    std::vector<Target> gram_cols(d);
+    std::vector<bool> in_work(d, false);
+    std::vector<size_t> work;
+
+    // One coordinate descent pass over given features, returns max weighted squared change of weights
+    auto pass = [&](const std::vector<size_t>& features, const double l1, const double l2)
+    {
+        double max_change = 0.0;
+        for (const size_t j : features)
+        {
+            if (col_sq[j] <= 0.0)
+                continue;
+            // Soft-thresholding of correlation with partial residual
+            const double z = corr[j] + col_sq[j] * beta[j];
+            const double shrunk = std::max(std::abs(z) - l1, 0.0);
+            const double updated = std::copysign(shrunk, z) / (col_sq[j] + l2);
+            const double delta = updated - beta[j];
+            if (delta == 0.0)
+                continue;
+            if (gram_cols[j].is_empty())
+                gram_cols[j] = X_features.t() * (X_features.col(j) - x_means[j]) / n;
+            corr -= gram_cols[j] * delta;
+            beta[j] = updated;
+            max_change = std::max(max_change, col_sq[j] * delta * delta);
+        }
+        return max_change;
+    };
+
+    // 3. Whole path with warm starts: previous solution is the starting point for next lambda
+    double lambda_prev = arma::max(arma::abs(corr)) / alpha_;
+    for (size_t i = 0; i < lambdas_.n_rows; ++i)
+    {
+        const double lambda = lambdas_[i];
+        const double l1 = lambda * alpha_;
+        const double l2 = lambda * (1.0 - alpha_);
+        // Strong rule: discard feature j if |c_j| < alpha (2 lambda - lambda_prev)
+        const double strong = alpha_ * (2.0 * lambda - lambda_prev);
+        for (size_t j = 0; j < d; ++j)
+        {
+            if (!in_work[j] && std::abs(corr[j]) >= strong)
+            {
+                in_work[j] = true;
+                work.push_back(j);
+            }
+        }
+        while (true)
+        {
+            // Full pass over working set, then cycle over active (non-zero) weights only until convergence
+            size_t iter = 0;
+            while (iter++ < max_iter_ && pass(work, l1, l2) >= tol_)
+            {
+                std::vector<size_t> active;
+                for (const size_t j : work)
+                    if (beta[j] != 0.0)
+                        active.push_back(j);
+                while (iter++ < max_iter_ && pass(active, l1, l2) >= tol_) {}
+            }
+            // KKT check of screened out features: zero weight is optimal only if |c_j| <= alpha lambda
+            bool violated = false;
+            for (size_t j = 0; j < d; ++j)
+            {
+                if (!in_work[j] && std::abs(corr[j]) > l1)
+                {
+                    in_work[j] = true;
+                    work.push_back(j);
+                    violated = true;
+                }
+            }
+            if (!violated)
+                break;
+        }
+
+        // Weights with intercept
+        path_(i, 0) = y_mean - arma::dot(x_means, beta);
+        path_.submat(i, 1, i, d) = beta.t();
+        // SSE = |y|^2 - 2 beta^T X^T y + beta^T G beta, where G beta = X^T y - n c
+        const double sse = sst - arma::dot(beta, xty) - n * arma::dot(beta, corr);
+        // Degrees of freedom: non-zero weights and intercept
+        const double df = arma::accu(beta != 0.0) + 1.0;
+        gcv_[i] = (n > df) ? n * sse / ((n - df) * (n - df)) : arma::datum::inf;
+        lambda_prev = lambda;
+    }
+
+    return path_.row(gcv_.index_min());
+}
+
+const BatchWeights ElasticNetSolver::get_path() const
+{
+    return path_;
+}
+
+const Lambdas ElasticNetSolver::get_lambdas() const
+{
+    return lambdas_;
+}
+
+const Target ElasticNetSolver::get_gcv() const
+{
+    return gcv_;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file halving_search.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief HalvingSearch class implementation
+ * @version 0.1
+ * @date 2024-05-10
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <cstring>
+#include <armadillo>
+#include <boost/random.hpp>
+#include "halving_search.hpp"
+#include "derivative_solver.hpp"
+#include "exceptions.hpp"
+#include "stats.hpp"
+
+namespace
+{
+    // Check for infinity or NaN on exponent bits, since `std::isfinite` is folded away by -ffast-math
+    bool is_finite(const double value)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & 0x7FF0000000000000ULL) != 0x7FF0000000000000ULL;
+    }
+}
+
+HalvingSearch::HalvingSearch(const std::function<Derivative(const Weights&, const Features&, const Target&)>& diff_loss_func,
+                             const std::function<Target(const Features&, const Weights&)>& predict_func,
+                             const std::function<double(const Target&, const Target&)>& metric_func,
+                             const std::vector<double>& learning_rates,
+                             const std::vector<double>& min_derivative_sizes,
+                             const size_t min_iter,
+                             const size_t max_iter,
+                             const size_t eta /*=3*/,
+                             const bool greater_is_better /*=false*/)
+: diff_loss_func_(diff_loss_func)
+, predict_func_(predict_func)
+, metric_func_(metric_func)
+, learning_rates_(learning_rates)
+, min_derivative_sizes_(min_derivative_sizes)
+, min_iter_(std::max<size_t>(min_iter, 1))
+, max_iter_(std::max(max_iter, min_iter))
+, eta_(std::max<size_t>(eta, 2))
+, greater_is_better_(greater_is_better)
+, best_()
+{
+    // Init search here
+    // Set search's name as string representation of its type
+    name_ = Types::get_name(*this);
+}
+
+HalvingSearch& HalvingSearch::fit(const Features& X_train, const Target& y_train, const Features& X_val, const Target& y_val, const unsigned int seed /*=0*/)
+{
+    // Full grid
+    std::vector<size_t> configs(learning_rates_.size() * min_derivative_sizes_.size());
+    std::iota(configs.begin(), configs.end(), 0);
+    halve_(X_train, y_train, X_val, y_val, configs, seed);
+    // Return object for possible cascading in pipelines
+    return *this;
+}
+
+HalvingSearch& HalvingSearch::fit_random(const Features& X_train, const Target& y_train, const Features& X_val, const Target& y_val, const size_t num_samples, const unsigned int seed)
+{
+    // Random sample (without replacement) of grid
+    std::vector<size_t> configs(learning_rates_.size() * min_derivative_sizes_.size());
+    std::iota(configs.begin(), configs.end(), 0);
+    boost::mt19937 rng(seed);
+    for (size_t i = 0; i + 1 < configs.size() && i < num_samples; ++i)
+    {
+        boost::random::uniform_int_distribution<size_t> pick(i, configs.size() - 1);
+        std::swap(configs[i], configs[pick(rng)]);
+    }
+    configs.resize(std::min(num_samples, configs.size()));
+    halve_(X_train, y_train, X_val, y_val, configs, seed);
+    // Return object for possible cascading in pipelines
+    return *this;
+}
+
+void HalvingSearch::halve_(const Features& X_train, const Target& y_train, const Features& X_val, const Target& y_val, 
+                           const std::vector<size_t>& configs, const unsigned int seed)
+{
+    // Throw if there is nothing to search, i.e. empty grid or no samples of it
+    if (configs.empty())
+        throw EmptyGridException();
+
+    // 1. By default, intercept weight (w_0) is learned, so add dummy feature for it
+    // These copies are shared read-only by all workers
+    Features X_train_full = X_train;
+    X_train_full.insert_cols(0, Features(X_train.n_rows, 1, arma::fill::ones));
+    Features X_val_full = X_val;
+    X_val_full.insert_cols(0, Features(X_val.n_rows, 1, arma::fill::ones));
+
+    // 2. Same initial weights with Gaussian noise N(0, 1) for all configurations
+    const size_t num_configs = configs.size();
+    // Local engine, so the search neither depends on nor changes global random state
+    boost::mt19937 rng(seed);
+    boost::random::normal_distribution<> normal;
+    Weights w_init(X_train_full.n_cols);
+    for (double& w : w_init)
+        w = normal(rng);
+    std::vector<Weights> weights(num_configs, w_init);
+    configs_.set_size(num_configs, 3);
+    scores_.set_size(num_configs);
+    for (size_t c = 0; c < num_configs; ++c)
+    {
+        configs_(c, 0) = learning_rates_[configs[c] / min_derivative_sizes_.size()];
+        configs_(c, 1) = 0;
+        configs_(c, 2) = min_derivative_sizes_[configs[c] % min_derivative_sizes_.size()];
+    }
+
+    // Failed or diverged configurations are ranked last, then by loss to minimize
+    // Flags are bytes, not `std::vector<bool>` bits, so workers may set them concurrently
+    std::vector<char> failed(num_configs, false);
+    const double sign = greater_is_better_ ? -1.0 : 1.0;
+    auto is_better = [&](const size_t a, const size_t b)
+    {
+        if (failed[a] != failed[b])
+            return !failed[a];
+        return sign * scores_[a] < sign * scores_[b];
+    };
+
+    // 3. Successive halving rounds
+    std::vector<size_t> alive(num_configs);
+    std::iota(alive.begin(), alive.end(), 0);
+    size_t budget = min_iter_;
+    while (!alive.empty())
+    {
+        // Continue every alive configuration from its current weights up to `budget` iterations
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (size_t a = 0; a < alive.size(); ++a)
+        {
+            EZML_TRACE_SCOPE(name_, "train_config");
+            const size_t c = alive[a];
+            const size_t extra_iter = budget - static_cast<size_t>(configs_(c, 1));
+            try
+            {
+                DerivativeSolver solver(diff_loss_func_, configs_(c, 0), extra_iter, configs_(c, 2), false);
+                solver.optimize(weights[c], X_train_full, y_train);
+                scores_[c] = metric_func_(y_val, predict_func_(X_val_full, weights[c]));
+                failed[c] = !is_finite(scores_[c]);
+            }
+            catch (...)
+            {
+                // Exceptions must not escape parallel region, i.e. `NewtonShapeException`
+                scores_[c] = arma::datum::nan;
+                failed[c] = true;
+            }
+            configs_(c, 1) = budget;
+        }
+        if (alive.size() == 1 || budget >= max_iter_)
+            break;
+        // Keep best 1 / eta configurations
+        std::stable_sort(alive.begin(), alive.end(), is_better);
+        alive.resize(std::max<size_t>(alive.size() / eta_, 1));
+        budget = std::min(budget * eta_, max_iter_);
+    }
+
+    // 4. Best configuration of last round
+    best_ = alive.empty() ? 0 : *std::min_element(alive.begin(), alive.end(), is_better);
+    best_weights_ = weights.empty() ? Weights() : weights[best_];
+}
+
+const Features HalvingSearch::get_configs() const
+{
+    return configs_;
+}
+
+const Target HalvingSearch::get_scores() const
+{
+    return scores_;
+}
+
+const arma::drowvec HalvingSearch::get_best_config() const
+{
+    // Throw if not searched yet
+    if (configs_.is_empty())
+        throw NotFittedException(get_name());
+    return configs_.row(best_);
+}
+
+const Weights HalvingSearch::get_best_weights() const
+{
+    // Throw if not searched yet
+    if (configs_.is_empty())
+        throw NotFittedException(get_name());
+    return best_weights_;
+}
+
+const double HalvingSearch::get_best_score() const
+{
+    // Throw if not searched yet
+    if (configs_.is_empty())
+        throw NotFittedException(get_name());
+    return scores_[best_];
+}
+
+const std::string HalvingSearch::get_name() const
+{
+    return name_;
+}
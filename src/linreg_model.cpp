@@ -17,6 +17,9 @@
 #include "ols_solver.hpp"
 #include "qr_solver.hpp"
 #include "derivative_solver.hpp"
+#include "typed_derivative_solver.hpp"
+#include "ridge_solver.hpp"
+#include "elastic_net_solver.hpp"
 
 template <typename SolverType>
 LinRegModel<SolverType>::LinRegModel(const SolverType& solver)
@@ -29,58 +32,170 @@ LinRegModel<SolverType>::LinRegModel(const SolverType& solver)
 }
 
 template <typename SolverType>
-const Weights LinRegModel<SolverType>::get_weights() const
+const Weights& LinRegModel<SolverType>::get_weights() const
 {
     return weights_;
 }
 
 template <typename SolverType>
-const LinRegModel<SolverType> LinRegModel<SolverType>::fit(Features& X, const Target& y)
+const SolverType& LinRegModel<SolverType>::get_solver() const
+{
+    return solver_;
+}
+
+template <typename SolverType>
+LinRegModel<SolverType>& LinRegModel<SolverType>::fit(Features& X, const Target& y)
 {
 
+    EZML_PHASE(stats_, name_, "fit");
     // 1. By default, intercept weight (w_0) is learned, so add dummy feature for it
-    Features dummy_feature = Features(X.n_rows, 1, arma::fill::ones);
-    //std::cout << dummy_feature;
-    X.insert_cols(0, dummy_feature);
-    // 2. Init weights with Gaussian noise N(0, 1)
-    weights_ = Weights(X.n_cols, arma::fill::randn);
+    {
+        EZML_PHASE(stats_, name_, "add_intercept");
+        // Dummy feature, then copy of features one column wider
+        EZML_BYTES(stats_, "add_intercept", X.n_rows * (X.n_cols + 2) * sizeof(double));
+        Features dummy_feature = Features(X.n_rows, 1, arma::fill::ones);
+        //std::cout << dummy_feature;
+        X.insert_cols(0, dummy_feature);
+    }
+    // 2. Init weights: warm start from given or current weights, or Gaussian noise N(0, 1)
+    weights_ = init_weights_(weights_, X.n_cols);
     // 3. Learn weights with solver
-    weights_ = solver_.optimize(weights_, X, y);
+    {
+        EZML_PHASE(stats_, name_, "optimize");
+        weights_ = solver_.optimize(weights_, X, y);
+    }
     // 4. Model is fitted now
     mark_as_fitted_();
     // Return object for possible cascading in pipelines
     return *this;
 }
 
+template <typename SolverType>
+LinRegModel<SolverType>& LinRegModel<SolverType>::fit(Features& X, const Target& y, const Features& X_val, const Target& y_val)
+{
+    EZML_PHASE(stats_, name_, "fit");
+    // 1. By default, intercept weight (w_0) is learned, so add dummy feature for it, to validation features too
+    Features X_val_full;
+    {
+        EZML_PHASE(stats_, name_, "add_intercept");
+        EZML_BYTES(stats_, "add_intercept", (X.n_rows * (X.n_cols + 2) + X_val.n_rows * (2 * X_val.n_cols + 2)) * sizeof(double));
+        X.insert_cols(0, Features(X.n_rows, 1, arma::fill::ones));
+        X_val_full = X_val;
+        X_val_full.insert_cols(0, Features(X_val.n_rows, 1, arma::fill::ones));
+    }
+    // 2. Init weights: warm start from given or current weights, or Gaussian noise N(0, 1)
+    weights_ = init_weights_(weights_, X.n_cols);
+    // 3. Learn weights with solver, best ones on validation data
+    {
+        EZML_PHASE(stats_, name_, "optimize");
+        weights_ = solver_.optimize(weights_, X, y, X_val_full, y_val);
+    }
+    // 4. Model is fitted now
+    mark_as_fitted_();
+    // Return object for possible cascading in pipelines
+    return *this;
+}
+
+template <typename SolverType>
+LinRegModel<SolverType>& LinRegModel<SolverType>::fit(const BlockSource& source)
+{
+    EZML_PHASE(stats_, name_, "fit");
+    // 1. Init weights: warm start from given or current weights, or Gaussian noise N(0, 1), intercept weight (w_0) included
+    weights_ = init_weights_(weights_, source.get_num_features() + 1);
+    // 2. Learn weights with solver, one or more passes over blocks
+    {
+        EZML_PHASE(stats_, name_, "optimize");
+        weights_ = solver_.optimize(weights_, source);
+    }
+    // 3. Model is fitted now
+    mark_as_fitted_();
+    // Return object for possible cascading in pipelines
+    return *this;
+}
+
 template <typename SolverType>
 const Target LinRegModel<SolverType>::predict(const Features& X) const
+{
+    Target y_pred;
+    predict_into(X, y_pred);
+    return y_pred;
+}
+
+template <typename SolverType>
+void LinRegModel<SolverType>::predict_into(const Features& X, Target& out) const
 {
     // Throw if not fitted yet
     if (!is_fitted())
         throw NotFittedException(get_name());
 
-    const Target y_pred = Predict::linreg(X, weights_);
-    return y_pred;
+    EZML_TRACE_SCOPE(name_, "predict");
+    // Matrix-vector product written straight into output
+    out = X * weights_.t();
 }
 
 // Explicitly instantiate templates for actual required types
 // BaseSolver
 template LinRegModel<BaseSolver>::LinRegModel(const BaseSolver&);
-template const Weights LinRegModel<BaseSolver>::get_weights() const;
-template const LinRegModel<BaseSolver> LinRegModel<BaseSolver>::fit(Features&, const Target&);
+template const Weights& LinRegModel<BaseSolver>::get_weights() const;
+template const BaseSolver& LinRegModel<BaseSolver>::get_solver() const;
+template LinRegModel<BaseSolver>& LinRegModel<BaseSolver>::fit(Features&, const Target&);
 template const Target LinRegModel<BaseSolver>::predict(const Features&) const;
+template void LinRegModel<BaseSolver>::predict_into(const Features&, Target&) const;
 // OLSSolver
 template LinRegModel<OLSSolver>::LinRegModel(const OLSSolver&);
-template const Weights LinRegModel<OLSSolver>::get_weights() const;
-template const LinRegModel<OLSSolver> LinRegModel<OLSSolver>::fit(Features&, const Target&);
+template const Weights& LinRegModel<OLSSolver>::get_weights() const;
+template const OLSSolver& LinRegModel<OLSSolver>::get_solver() const;
+template LinRegModel<OLSSolver>& LinRegModel<OLSSolver>::fit(Features&, const Target&);
+template LinRegModel<OLSSolver>& LinRegModel<OLSSolver>::fit(const BlockSource&);
 template const Target LinRegModel<OLSSolver>::predict(const Features&) const;
+template void LinRegModel<OLSSolver>::predict_into(const Features&, Target&) const;
 // QRSolver
 template LinRegModel<QRSolver>::LinRegModel(const QRSolver&);
-template const Weights LinRegModel<QRSolver>::get_weights() const;
-template const LinRegModel<QRSolver> LinRegModel<QRSolver>::fit(Features&, const Target&);
+template const Weights& LinRegModel<QRSolver>::get_weights() const;
+template const QRSolver& LinRegModel<QRSolver>::get_solver() const;
+template LinRegModel<QRSolver>& LinRegModel<QRSolver>::fit(Features&, const Target&);
+template LinRegModel<QRSolver>& LinRegModel<QRSolver>::fit(const BlockSource&);
 template const Target LinRegModel<QRSolver>::predict(const Features&) const;
+template void LinRegModel<QRSolver>::predict_into(const Features&, Target&) const;
 // DerivativeSolver
 template LinRegModel<DerivativeSolver>::LinRegModel(const DerivativeSolver&);
-template const Weights LinRegModel<DerivativeSolver>::get_weights() const;
-template const LinRegModel<DerivativeSolver> LinRegModel<DerivativeSolver>::fit(Features&, const Target&);
+template const Weights& LinRegModel<DerivativeSolver>::get_weights() const;
+template const DerivativeSolver& LinRegModel<DerivativeSolver>::get_solver() const;
+template LinRegModel<DerivativeSolver>& LinRegModel<DerivativeSolver>::fit(Features&, const Target&);
+template LinRegModel<DerivativeSolver>& LinRegModel<DerivativeSolver>::fit(const BlockSource&);
+template LinRegModel<DerivativeSolver>& LinRegModel<DerivativeSolver>::fit(Features&, const Target&, const Features&, const Target&);
 template const Target LinRegModel<DerivativeSolver>::predict(const Features&) const;
+template void LinRegModel<DerivativeSolver>::predict_into(const Features&, Target&) const;
+// TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>
+template LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::LinRegModel(const TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>&);
+template const Weights& LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::get_weights() const;
+template const TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>& LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::get_solver() const;
+template LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>& LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::fit(Features&, const Target&);
+template LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>& LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::fit(const BlockSource&);
+template LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>& LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::fit(Features&, const Target&, const Features&, const Target&);
+template const Target LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::predict(const Features&) const;
+template void LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>::predict_into(const Features&, Target&) const;
+// TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>
+template LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>>::LinRegModel(const TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>&);
+template const Weights& LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>>::get_weights() const;
+template const TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>& LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>>::get_solver() const;
+template LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>>& LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>>::fit(Features&, const Target&);
+template LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>>& LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>>::fit(const BlockSource&);
+template LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>>& LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>>::fit(Features&, const Target&, const Features&, const Target&);
+template const Target LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>>::predict(const Features&) const;
+template void LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>>::predict_into(const Features&, Target&) const;
+// RidgeSolver
+template LinRegModel<RidgeSolver>::LinRegModel(const RidgeSolver&);
+template const Weights& LinRegModel<RidgeSolver>::get_weights() const;
+template const RidgeSolver& LinRegModel<RidgeSolver>::get_solver() const;
+template LinRegModel<RidgeSolver>& LinRegModel<RidgeSolver>::fit(Features&, const Target&);
+template LinRegModel<RidgeSolver>& LinRegModel<RidgeSolver>::fit(const BlockSource&);
+template const Target LinRegModel<RidgeSolver>::predict(const Features&) const;
+template void LinRegModel<RidgeSolver>::predict_into(const Features&, Target&) const;
+// ElasticNetSolver
+template LinRegModel<ElasticNetSolver>::LinRegModel(const ElasticNetSolver&);
+template const Weights& LinRegModel<ElasticNetSolver>::get_weights() const;
+template const ElasticNetSolver& LinRegModel<ElasticNetSolver>::get_solver() const;
+template LinRegModel<ElasticNetSolver>& LinRegModel<ElasticNetSolver>::fit(Features&, const Target&);
+template const Target LinRegModel<ElasticNetSolver>::predict(const Features&) const;
+template void LinRegModel<ElasticNetSolver>::predict_into(const Features&, Target&) const;
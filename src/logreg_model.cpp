@@ -15,6 +15,7 @@
 #include "predict_functions.hpp"
 #include "base_solver.hpp"
 #include "derivative_solver.hpp"
+#include "typed_derivative_solver.hpp"
 
 template <typename SolverType>
 LogRegModel<SolverType>::LogRegModel(const SolverType& solver)
@@ -27,23 +28,32 @@ LogRegModel<SolverType>::LogRegModel(const SolverType& solver)
 }
 
 template <typename SolverType>
-const Weights LogRegModel<SolverType>::get_weights() const
+const Weights& LogRegModel<SolverType>::get_weights() const
 {
     return weights_;
 }
 
 template <typename SolverType>
-const LogRegModel<SolverType> LogRegModel<SolverType>::fit(Features& X, const Target& y)
+LogRegModel<SolverType>& LogRegModel<SolverType>::fit(Features& X, const Target& y)
 {
 
+    EZML_PHASE(stats_, name_, "fit");
     // 1. By default, intercept weight (w_0) is learned, so add dummy feature for it
-    Features dummy_feature = Features(X.n_rows, 1, arma::fill::ones);
-    //std::cout << dummy_feature;
-    X.insert_cols(0, dummy_feature);
-    // 2. Init weights with Gaussian noise N(0, 1)
-    weights_ = Weights(X.n_cols, arma::fill::randn);
+    {
+        EZML_PHASE(stats_, name_, "add_intercept");
+        // Dummy feature, then copy of features one column wider
+        EZML_BYTES(stats_, "add_intercept", X.n_rows * (X.n_cols + 2) * sizeof(double));
+        Features dummy_feature = Features(X.n_rows, 1, arma::fill::ones);
+        //std::cout << dummy_feature;
+        X.insert_cols(0, dummy_feature);
+    }
+    // 2. Init weights: warm start from given or current weights, or Gaussian noise N(0, 1)
+    weights_ = init_weights_(weights_, X.n_cols);
     // 3. Learn weights with solver
-    weights_ = solver_.optimize(weights_, X, y);
+    {
+        EZML_PHASE(stats_, name_, "optimize");
+        weights_ = solver_.optimize(weights_, X, y);
+    }
     // 4. Model is fitted now
     mark_as_fitted_();
     // Return object for possible cascading in pipelines
@@ -51,37 +61,116 @@ const LogRegModel<SolverType> LogRegModel<SolverType>::fit(Features& X, const Ta
 }
 
 template <typename SolverType>
-const Target LogRegModel<SolverType>::predict(const Features& X, const double& threshold) const
+LogRegModel<SolverType>& LogRegModel<SolverType>::fit(Features& X, const Target& y, const Features& X_val, const Target& y_val)
 {
+    EZML_PHASE(stats_, name_, "fit");
+    // 1. By default, intercept weight (w_0) is learned, so add dummy feature for it, to validation features too
+    Features X_val_full;
+    {
+        EZML_PHASE(stats_, name_, "add_intercept");
+        EZML_BYTES(stats_, "add_intercept", (X.n_rows * (X.n_cols + 2) + X_val.n_rows * (2 * X_val.n_cols + 2)) * sizeof(double));
+        X.insert_cols(0, Features(X.n_rows, 1, arma::fill::ones));
+        X_val_full = X_val;
+        X_val_full.insert_cols(0, Features(X_val.n_rows, 1, arma::fill::ones));
+    }
+    // 2. Init weights: warm start from given or current weights, or Gaussian noise N(0, 1)
+    weights_ = init_weights_(weights_, X.n_cols);
+    // 3. Learn weights with solver, best ones on validation data
+    {
+        EZML_PHASE(stats_, name_, "optimize");
+        weights_ = solver_.optimize(weights_, X, y, X_val_full, y_val);
+    }
+    // 4. Model is fitted now
+    mark_as_fitted_();
+    // Return object for possible cascading in pipelines
+    return *this;
+}
 
-    // 1. Predict probability of positive class
-    const Target y_pred_proba = predict_proba(X);
-    // 2. Classify (binarize) probability at given threshold
-    const Target y_pred = Predict::logreg_class(y_pred_proba, threshold);
+template <typename SolverType>
+LogRegModel<SolverType>& LogRegModel<SolverType>::fit(const BlockSource& source)
+{
+    EZML_PHASE(stats_, name_, "fit");
+    // 1. Init weights: warm start from given or current weights, or Gaussian noise N(0, 1), intercept weight (w_0) included
+    weights_ = init_weights_(weights_, source.get_num_features() + 1);
+    // 2. Learn weights with solver, one or more passes over blocks
+    {
+        EZML_PHASE(stats_, name_, "optimize");
+        weights_ = solver_.optimize(weights_, source);
+    }
+    // 3. Model is fitted now
+    mark_as_fitted_();
+    // Return object for possible cascading in pipelines
+    return *this;
+}
+
+template <typename SolverType>
+const Target LogRegModel<SolverType>::predict(const Features& X, const double& threshold) const
+{
+    Target y_pred;
+    predict_into(X, y_pred, threshold);
     return y_pred;
 }
 
 template <typename SolverType>
 const Target LogRegModel<SolverType>::predict_proba(const Features& X) const
+{
+    Target y_pred_proba;
+    predict_proba_into(X, y_pred_proba);
+    return y_pred_proba;
+}
+
+template <typename SolverType>
+void LogRegModel<SolverType>::predict_into(const Features& X, Target& out, const double threshold) const
+{
+    // 1. Predict probability of positive class
+    predict_proba_into(X, out);
+    // 2. Classify (binarize) probability at given threshold in place
+    out.transform([threshold](const double proba) { return proba >= threshold ? 1.0 : 0.0; });
+}
+
+template <typename SolverType>
+void LogRegModel<SolverType>::predict_proba_into(const Features& X, Target& out) const
 {
     // Throw if not fitted yet
     if (!is_fitted())
         throw NotFittedException(get_name());
 
-    const Target y_pred_proba = Predict::logreg_proba(X, weights_);
-    return y_pred_proba;
+    EZML_TRACE_SCOPE(name_, "predict");
+    // Scores, then logistic function, both in place
+    out = X * weights_.t();
+    out = 1.0 / (1.0 + arma::exp(-out));
 }
 
 // Explicitly instantiate templates for actual required types
 // BaseSolver
 template LogRegModel<BaseSolver>::LogRegModel(const BaseSolver&);
-template const Weights LogRegModel<BaseSolver>::get_weights() const;
-template const LogRegModel<BaseSolver> LogRegModel<BaseSolver>::fit(Features&, const Target&);
+template const Weights& LogRegModel<BaseSolver>::get_weights() const;
+template LogRegModel<BaseSolver>& LogRegModel<BaseSolver>::fit(Features&, const Target&);
 template const Target LogRegModel<BaseSolver>::predict(const Features&, const double&) const;
 template const Target LogRegModel<BaseSolver>::predict_proba(const Features&) const;
+template void LogRegModel<BaseSolver>::predict_into(const Features&, Target&, const double) const;
+template void LogRegModel<BaseSolver>::predict_proba_into(const Features&, Target&) const;
 // DerivativeSolver
 template LogRegModel<DerivativeSolver>::LogRegModel(const DerivativeSolver&);
-template const Weights LogRegModel<DerivativeSolver>::get_weights() const;
-template const LogRegModel<DerivativeSolver> LogRegModel<DerivativeSolver>::fit(Features&, const Target&);
+template const Weights& LogRegModel<DerivativeSolver>::get_weights() const;
+template LogRegModel<DerivativeSolver>& LogRegModel<DerivativeSolver>::fit(Features&, const Target&);
+template LogRegModel<DerivativeSolver>& LogRegModel<DerivativeSolver>::fit(const BlockSource&);
+template LogRegModel<DerivativeSolver>& LogRegModel<DerivativeSolver>::fit(Features&, const Target&, const Features&, const Target&);
 template const Target LogRegModel<DerivativeSolver>::predict(const Features&, const double&) const;
-template const Target LogRegModel<DerivativeSolver>::predict_proba(const Features&) const;
\ No newline at end of file
+template const Target LogRegModel<DerivativeSolver>::predict_proba(const Features&) const;
+// TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>
+template LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>>::LogRegModel(const TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>&);
+template const Weights& LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>>::get_weights() const;
+template LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>>& LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>>::fit(Features&, const Target&);
+template LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>>& LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>>::fit(const BlockSource&);
+template LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>>& LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>>::fit(Features&, const Target&, const Features&, const Target&);
+template const Target LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>>::predict(const Features&, const double&) const;
+template const Target LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>>::predict_proba(const Features&) const;
+// TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>
+template LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>>::LogRegModel(const TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>&);
+template const Weights& LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>>::get_weights() const;
+template LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>>& LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>>::fit(Features&, const Target&);
+template LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>>& LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>>::fit(const BlockSource&);
+template LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>>& LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>>::fit(Features&, const Target&, const Features&, const Target&);
+template const Target LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>>::predict(const Features&, const double&) const;
+template const Target LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>>::predict_proba(const Features&) const;
@@ -0,0 +1,68 @@
+/**
+ * @file mapped_file.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief MappedFile class implementation
+ * @version 0.1
+ * @date 2024-05-27
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mapped_file.hpp"
+#include "exceptions.hpp"
+
+MappedFile::MappedFile(const std::string& path, const bool writable /*=false*/)
+: data_(nullptr)
+, size_(0)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw DataFileException(path, "cannot be opened");
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        throw DataFileException(path, "cannot be read");
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0)
+    {
+        const int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        void* addr = ::mmap(nullptr, size_, prot, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED)
+        {
+            ::close(fd);
+            throw DataFileException(path, "cannot be memory-mapped");
+        }
+        ::madvise(addr, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<char*>(addr);
+    }
+    // Mapping stays valid after the descriptor is closed
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+        ::munmap(data_, size_);
+}
+
+char* MappedFile::begin() const
+{
+    return data_;
+}
+
+char* MappedFile::end() const
+{
+    return data_ + size_;
+}
+
+size_t MappedFile::size() const
+{
+    return size_;
+}
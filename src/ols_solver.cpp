@@ -21,6 +21,28 @@ OLSSolver::OLSSolver()
 
 const Weights OLSSolver::optimize(Weights& w, const Features& X, const Target& y)
 {
+    EZML_PHASE(stats_, name_, "solve");
+    // Gram matrix and moments of normal equations
+    EZML_BYTES(stats_, "solve", (X.n_cols + 1) * X.n_cols * sizeof(double));
     const Weights weights = Predict::ols(X, y);
     return weights;
 }
+
+const Weights OLSSolver::optimize(Weights& w, const BlockSource& source)
+{
+    // 1. Sufficient statistics in one pass over blocks
+    Target means;
+    Features scatter;
+    {
+        EZML_PHASE(stats_, name_, "accumulate");
+        source.accumulate(means, scatter);
+    }
+    // 2. Solve centered normal equations, then recover intercept from means
+    EZML_PHASE(stats_, name_, "solve");
+    const size_t d = source.get_num_features();
+    const Target coefs = arma::solve(scatter.submat(0, 0, d - 1, d - 1), scatter.submat(0, d, d - 1, d), arma::solve_opts::likely_sympd);
+    Weights weights(d + 1);
+    weights[0] = means[d] - arma::dot(means.head(d), coefs);
+    weights.tail(d) = coefs.t();
+    return weights;
+}
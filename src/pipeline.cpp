@@ -0,0 +1,169 @@
+/**
+ * @file pipeline.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief Pipeline class implementation
+ * @version 0.1
+ * @date 2024-05-22
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <algorithm>
+#include <armadillo>
+#include "pipeline.hpp"
+#include "exceptions.hpp"
+#include "base_transformer.hpp"
+#include "standard_scaler.hpp"
+#include "linreg_model.hpp"
+#include "logreg_model.hpp"
+#include "softmax_reg_model.hpp"
+#include "base_solver.hpp"
+#include "ols_solver.hpp"
+#include "qr_solver.hpp"
+#include "derivative_solver.hpp"
+#include "typed_derivative_solver.hpp"
+#include "ridge_solver.hpp"
+#include "elastic_net_solver.hpp"
+
+namespace
+{
+    // Block of scores fits into L2 cache, so memory of prediction does not grow with number of rows
+    constexpr size_t SCORES_BLOCK_BYTES = 256 * 1024;
+    constexpr arma::uword MIN_SCORES_BLOCK_ROWS = 64;
+
+    // Models keep weights either as a row vector (one output) or as a matrix (one column per class),
+    // bring both to the matrix form with intercept in the first row
+    const ClassWeights as_columns(const Weights& w)
+    {
+        return w.t();
+    }
+
+    const ClassWeights as_columns(const ClassWeights& W)
+    {
+        return W;
+    }
+
+    // Score raw features without dummy feature and turn scores into predictions the same way each model does
+    template <typename SolverType>
+    void predict_with(const LinRegModel<SolverType>&, const Features& X, const ClassWeights& W, Target& out)
+    {
+        // One GEMV straight into output
+        out = X * W.col(0).tail(W.n_rows - 1);
+        out += W(0, 0);
+    }
+
+    template <typename SolverType>
+    void predict_with(const LogRegModel<SolverType>&, const Features& X, const ClassWeights& W, Target& out)
+    {
+        // Logistic function is monotonic, so class is decided by the sign of score
+        out = X * W.col(0).tail(W.n_rows - 1);
+        out += W(0, 0);
+        out.transform([](double score) { return score >= 0.0 ? 1.0 : 0.0; });
+    }
+
+    template <typename SolverType>
+    void predict_with(const SoftmaxRegModel<SolverType>&, const Features& X, const ClassWeights& W, Target& out)
+    {
+        // Blockwise GEMM into local cache-sized buffer, softmax keeps the order, so pick class with max score
+        const arma::uword block_rows = std::max<arma::uword>(MIN_SCORES_BLOCK_ROWS, SCORES_BLOCK_BYTES / (sizeof(double) * std::max<arma::uword>(W.n_cols, 1)));
+        Probabilities scores;
+        out.set_size(X.n_rows);
+        for (arma::uword first_row = 0; first_row < X.n_rows; first_row += block_rows)
+        {
+            const arma::uword last_row = std::min(first_row + block_rows, X.n_rows) - 1;
+            scores = X.rows(first_row, last_row) * W.tail_rows(W.n_rows - 1);
+            scores.each_row() += W.row(0);
+            for (arma::uword i = 0; i < scores.n_rows; ++i)
+                out[first_row + i] = static_cast<double>(scores.row(i).index_max());
+        }
+    }
+}
+
+template <typename TransformerType, typename ModelType>
+Pipeline<TransformerType, ModelType>::Pipeline(const TransformerType& transformer, const ModelType& model)
+: transformer_(transformer)
+, model_(model)
+, weights_()
+{
+    // Init pipeline here, if needed
+    // Set pipeline's name as string representation of its type
+    name_ = Types::get_name(*this);
+}
+
+template <typename TransformerType, typename ModelType>
+const ClassWeights& Pipeline<TransformerType, ModelType>::get_weights() const
+{
+    return weights_;
+}
+
+template <typename TransformerType, typename ModelType>
+const TransformerType& Pipeline<TransformerType, ModelType>::get_transformer() const
+{
+    return transformer_;
+}
+
+template <typename TransformerType, typename ModelType>
+const ModelType& Pipeline<TransformerType, ModelType>::get_model() const
+{
+    return model_;
+}
+
+template <typename TransformerType, typename ModelType>
+Pipeline<TransformerType, ModelType>& Pipeline<TransformerType, ModelType>::fit(Features& X, const Target& y)
+{
+    // 1. Fit transformer and transform features
+    Features X_transformed = transformer_.fit_transform(X);
+    // 2. Fit model on transformed features
+    // Note: `fit()` adds dummy feature to `X_transformed`, original `X` is left intact
+    model_.fit(X_transformed, y);
+    // 3. Fold transformation into model's weights, so raw features can be scored directly
+    weights_ = transformer_.fold(as_columns(model_.get_weights()));
+    // 4. Pipeline is fitted now
+    mark_as_fitted_();
+    // Return object for possible cascading in pipelines
+    return *this;
+}
+
+template <typename TransformerType, typename ModelType>
+const Target Pipeline<TransformerType, ModelType>::predict(const Features& X) const
+{
+    Target y_pred;
+    predict_into(X, y_pred);
+    return y_pred;
+}
+
+template <typename TransformerType, typename ModelType>
+void Pipeline<TransformerType, ModelType>::predict_into(const Features& X, Target& out) const
+{
+    // Throw if not fitted yet
+    if (!is_fitted())
+        throw NotFittedException(get_name());
+
+    // Score raw features without dummy feature: one GEMV for one output, one GEMM for many classes
+    predict_with(model_, X, weights_, out);
+}
+
+// Explicitly instantiate templates for actual required types
+// BaseTransformer
+template class Pipeline<BaseTransformer, LinRegModel<OLSSolver>>;
+template class Pipeline<BaseTransformer, LinRegModel<QRSolver>>;
+template class Pipeline<BaseTransformer, LinRegModel<DerivativeSolver>>;
+template class Pipeline<BaseTransformer, LinRegModel<RidgeSolver>>;
+template class Pipeline<BaseTransformer, LinRegModel<ElasticNetSolver>>;
+template class Pipeline<BaseTransformer, LogRegModel<DerivativeSolver>>;
+template class Pipeline<BaseTransformer, SoftmaxRegModel<DerivativeSolver>>;
+template class Pipeline<BaseTransformer, LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>>;
+template class Pipeline<BaseTransformer, LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>>>;
+template class Pipeline<BaseTransformer, SoftmaxRegModel<TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>>>;
+// StandardScaler
+template class Pipeline<StandardScaler, LinRegModel<OLSSolver>>;
+template class Pipeline<StandardScaler, LinRegModel<QRSolver>>;
+template class Pipeline<StandardScaler, LinRegModel<DerivativeSolver>>;
+template class Pipeline<StandardScaler, LinRegModel<RidgeSolver>>;
+template class Pipeline<StandardScaler, LinRegModel<ElasticNetSolver>>;
+template class Pipeline<StandardScaler, LogRegModel<DerivativeSolver>>;
+template class Pipeline<StandardScaler, SoftmaxRegModel<DerivativeSolver>>;
+template class Pipeline<StandardScaler, LinRegModel<TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>>>;
+template class Pipeline<StandardScaler, LogRegModel<TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>>>;
+template class Pipeline<StandardScaler, SoftmaxRegModel<TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>>>;
@@ -21,6 +21,32 @@ QRSolver::QRSolver()
 
 const Weights QRSolver::optimize(Weights& w, const Features& X, const Target& y)
 {
+    EZML_PHASE(stats_, name_, "solve");
+    // Factors Q and R of economical decomposition
+    EZML_BYTES(stats_, "solve", (X.n_rows + X.n_cols) * X.n_cols * sizeof(double));
     const Weights weights = Predict::qr(X, y);
     return weights;
 }
+
+const Weights QRSolver::optimize(Weights& w, const BlockSource& source)
+{
+    // 1. Fold blocks of [X, y] into triangular factor R one at a time
+    const size_t d = source.get_num_features();
+    Features R(0, d + 2);
+    Features X, Q, R_block;
+    Target y;
+    {
+        EZML_PHASE(stats_, name_, "decompose");
+        for (size_t block = 0; block < source.get_num_blocks(); ++block)
+        {
+            source.read(block, X, y);
+            arma::qr_econ(Q, R_block, arma::join_cols(R, arma::join_rows(X, y)));
+            R = R_block;
+        }
+    }
+    // 2. [X, y] = Q R, so X w = y reduces to triangular system R_xx w = R_xy
+    EZML_PHASE(stats_, name_, "solve");
+    const Target coefs = arma::solve(arma::trimatu(R.submat(0, 0, d, d)), R.submat(0, d + 1, d, d + 1));
+    const Weights weights = coefs.t();
+    return weights;
+}
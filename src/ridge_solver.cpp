@@ -0,0 +1,115 @@
+/**
+ * @file ridge_solver.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief RidgeSolver class implementation
+ * @version 0.1
+ * @date 2024-05-13
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <armadillo>
+#include "ridge_solver.hpp"
+#include "exceptions.hpp"
+
+RidgeSolver::RidgeSolver(const double lambda)
+: RidgeSolver(Lambdas({lambda}))
+{
+}
+
+RidgeSolver::RidgeSolver(const Lambdas& lambdas)
+: lambdas_(lambdas)
+{
+    // Throw if there is no lambda, or the path would divide by zero eigenvalue of rank-deficient Gram matrix
+    if (lambdas_.is_empty() || lambdas_.min() <= 0.0)
+        throw WrongLambdasException();
+    // Init solver here
+    // Set solver's name as string representation of its type
+    name_ = Types::get_name(*this);
+}
+
+const Weights RidgeSolver::optimize(Weights& w, const Features& X, const Target& y)
+{
+    const size_t d = X.n_cols - 1;
+
+    // Center features (except intercept) and target, so that intercept is not penalized
+    Weights x_means;
+    double y_mean;
+    Features gram;
+    Target moment;
+    double sst;
+    {
+        EZML_PHASE(stats_, name_, "gram");
+        EZML_BYTES(stats_, "gram", (X.n_rows + d + 2) * d * sizeof(double));
+        x_means = arma::mean(X.tail_cols(d), 0);
+        y_mean = arma::mean(y);
+        Features X_centered = X.tail_cols(d);
+        X_centered.each_row() -= x_means;
+        const Target y_centered = y - y_mean;
+        gram = X_centered.t() * X_centered;
+        moment = X_centered.t() * y_centered;
+        sst = arma::dot(y_centered, y_centered);
+    }
+    return solve_path_(X.n_rows, x_means, y_mean, gram, moment, sst);
+}
+
+const Weights RidgeSolver::optimize(Weights& w, const BlockSource& source)
+{
+    const size_t d = source.get_num_features();
+
+    // Centered statistics in one pass over blocks
+    Target means;
+    Features scatter;
+    {
+        EZML_PHASE(stats_, name_, "accumulate");
+        source.accumulate(means, scatter);
+    }
+    return solve_path_(source.get_num_rows(), means.head(d).t(), means[d], scatter.submat(0, 0, d - 1, d - 1), scatter.submat(0, d, d - 1, d), scatter(d, d));
+}
+
+const Weights RidgeSolver::solve_path_(const size_t n, const Weights& x_means, const double y_mean, const Features& gram, const Target& moment, const double sst)
+{
+    EZML_PHASE(stats_, name_, "solve_path");
+    const size_t d = gram.n_rows;
+    path_.set_size(lambdas_.n_rows, d + 1);
+    gcv_.set_size(lambdas_.n_rows);
+
+    // 1. Single eigendecomposition of centered Gram matrix
+    Target eigvals;
+    Features eigvecs;
+    arma::eig_sym(eigvals, eigvecs, gram);
+    eigvals.clamp(0.0, arma::datum::inf);
+    const Target projection = eigvecs.t() * moment;
+
+    // 2. Whole path: every lambda costs O(d^2)
+    for (size_t i = 0; i < lambdas_.n_rows; ++i)
+    {
+        const Target shrink = 1.0 / (eigvals + lambdas_[i]);
+        const Target coefs = eigvecs * (shrink % projection);
+        path_(i, 0) = y_mean - arma::dot(x_means, coefs);
+        path_.submat(i, 1, i, d) = coefs.t();
+        // SSE(lambda) = |y|^2 - 2 w^T X^T y + w^T X^T X w, in eigenbasis
+        const double sse = sst - arma::sum(arma::square(projection) % shrink % (2.0 - eigvals % shrink));
+        // Degrees of freedom include intercept
+        const double df = arma::sum(eigvals % shrink) + 1.0;
+        gcv_[i] = n * sse / ((n - df) * (n - df));
+    }
+
+    return path_.row(gcv_.index_min());
+}
+
+const BatchWeights RidgeSolver::get_path() const
+{
+    return path_;
+}
+
+const Lambdas RidgeSolver::get_lambdas() const
+{
+    return lambdas_;
+}
+
+const Target RidgeSolver::get_gcv() const
+{
+    return gcv_;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file softmax_reg_model.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief Multinomial (softmax) regression model class implementation
+ * @version 0.1
+ * @date 2024-05-20
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <algorithm>
+#include <armadillo>
+#include "softmax_reg_model.hpp"
+#include "exceptions.hpp"
+#include "predict_functions.hpp"
+#include "base_solver.hpp"
+#include "derivative_solver.hpp"
+#include "typed_derivative_solver.hpp"
+
+namespace
+{
+    // Block of scores fits into L2 cache, so memory of prediction does not grow with number of rows
+    constexpr size_t SCORES_BLOCK_BYTES = 256 * 1024;
+    constexpr arma::uword MIN_SCORES_BLOCK_ROWS = 64;
+}
+
+template <typename SolverType>
+SoftmaxRegModel<SolverType>::SoftmaxRegModel(const SolverType& solver)
+: weights_()
+, solver_(solver)
+{
+    // Init model here, if needed
+    // Set model's name as string representation of its type
+    name_ = Types::get_name(*this);
+}
+
+template <typename SolverType>
+const ClassWeights& SoftmaxRegModel<SolverType>::get_weights() const
+{
+    return weights_;
+}
+
+template <typename SolverType>
+const size_t SoftmaxRegModel<SolverType>::get_num_classes() const
+{
+    return weights_.n_cols;
+}
+
+template <typename SolverType>
+SoftmaxRegModel<SolverType>& SoftmaxRegModel<SolverType>::fit(Features& X, const Target& y)
+{
+
+    EZML_PHASE(stats_, name_, "fit");
+    // 1. By default, intercept weight (w_0) is learned, so add dummy feature for it
+    {
+        EZML_PHASE(stats_, name_, "add_intercept");
+        // Dummy feature, then copy of features one column wider
+        EZML_BYTES(stats_, "add_intercept", X.n_rows * (X.n_cols + 2) * sizeof(double));
+        Features dummy_feature = Features(X.n_rows, 1, arma::fill::ones);
+        X.insert_cols(0, dummy_feature);
+    }
+    // 2. Classes are labeled 0, 1, ..., K - 1, other labels are rejected by gradient of cross-entropy
+    if (y.max() < 0.0)
+        throw WrongLabelsException(y.max(), 0);
+    const size_t num_classes = static_cast<size_t>(y.max()) + 1;
+    // 3. Init weights: warm start from given or current weights, or Gaussian noise N(0, 1)
+    // Solvers work with row vectors, so weights of all classes are flattened column by column
+    Weights flat_weights = init_weights_(arma::vectorise(weights_).t(), X.n_cols * num_classes);
+    // 4. Learn weights of all classes at once with solver
+    {
+        EZML_PHASE(stats_, name_, "optimize");
+        flat_weights = solver_.optimize(flat_weights, X, y);
+    }
+    weights_ = arma::reshape(flat_weights, X.n_cols, num_classes);
+    // 5. Model is fitted now
+    mark_as_fitted_();
+    // Return object for possible cascading in pipelines
+    return *this;
+}
+
+template <typename SolverType>
+const Target SoftmaxRegModel<SolverType>::predict(const Features& X) const
+{
+    Target y_pred;
+    predict_into(X, y_pred);
+    return y_pred;
+}
+
+template <typename SolverType>
+const Probabilities SoftmaxRegModel<SolverType>::predict_proba(const Features& X) const
+{
+    Probabilities y_pred_proba;
+    predict_proba_into(X, y_pred_proba);
+    return y_pred_proba;
+}
+
+template <typename SolverType>
+void SoftmaxRegModel<SolverType>::predict_into(const Features& X, Target& out) const
+{
+    // Throw if not fitted yet
+    if (!is_fitted())
+        throw NotFittedException(get_name());
+
+    EZML_TRACE_SCOPE(name_, "predict");
+    // 1. Scores of all classes are computed blockwise into local cache-sized buffer
+    const arma::uword block_rows = std::max<arma::uword>(MIN_SCORES_BLOCK_ROWS, SCORES_BLOCK_BYTES / (sizeof(double) * std::max<arma::uword>(weights_.n_cols, 1)));
+    Probabilities scores;
+    out.set_size(X.n_rows);
+    for (arma::uword first_row = 0; first_row < X.n_rows; first_row += block_rows)
+    {
+        const arma::uword last_row = std::min(first_row + block_rows, X.n_rows) - 1;
+        scores = X.rows(first_row, last_row) * weights_;
+        // 2. Pick class with max score, softmax keeps the order
+        for (arma::uword i = 0; i < scores.n_rows; ++i)
+            out[first_row + i] = static_cast<double>(scores.row(i).index_max());
+    }
+}
+
+template <typename SolverType>
+void SoftmaxRegModel<SolverType>::predict_proba_into(const Features& X, Probabilities& out) const
+{
+    // Throw if not fitted yet
+    if (!is_fitted())
+        throw NotFittedException(get_name());
+
+    EZML_TRACE_SCOPE(name_, "predict_proba");
+    out = X * weights_;
+    Predict::softmax_function_inplace(out);
+}
+
+// Explicitly instantiate templates for actual required types
+// BaseSolver
+template SoftmaxRegModel<BaseSolver>::SoftmaxRegModel(const BaseSolver&);
+template const ClassWeights& SoftmaxRegModel<BaseSolver>::get_weights() const;
+template const size_t SoftmaxRegModel<BaseSolver>::get_num_classes() const;
+template SoftmaxRegModel<BaseSolver>& SoftmaxRegModel<BaseSolver>::fit(Features&, const Target&);
+template const Target SoftmaxRegModel<BaseSolver>::predict(const Features&) const;
+template const Probabilities SoftmaxRegModel<BaseSolver>::predict_proba(const Features&) const;
+template void SoftmaxRegModel<BaseSolver>::predict_into(const Features&, Target&) const;
+template void SoftmaxRegModel<BaseSolver>::predict_proba_into(const Features&, Probabilities&) const;
+// DerivativeSolver
+template SoftmaxRegModel<DerivativeSolver>::SoftmaxRegModel(const DerivativeSolver&);
+template const ClassWeights& SoftmaxRegModel<DerivativeSolver>::get_weights() const;
+template const size_t SoftmaxRegModel<DerivativeSolver>::get_num_classes() const;
+template SoftmaxRegModel<DerivativeSolver>& SoftmaxRegModel<DerivativeSolver>::fit(Features&, const Target&);
+template const Target SoftmaxRegModel<DerivativeSolver>::predict(const Features&) const;
+template const Probabilities SoftmaxRegModel<DerivativeSolver>::predict_proba(const Features&) const;
+template void SoftmaxRegModel<DerivativeSolver>::predict_into(const Features&, Target&) const;
+template void SoftmaxRegModel<DerivativeSolver>::predict_proba_into(const Features&, Probabilities&) const;
+// TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>
+template SoftmaxRegModel<TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>>::SoftmaxRegModel(const TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>&);
+template const ClassWeights& SoftmaxRegModel<TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>>::get_weights() const;
+template const size_t SoftmaxRegModel<TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>>::get_num_classes() const;
+template SoftmaxRegModel<TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>>& SoftmaxRegModel<TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>>::fit(Features&, const Target&);
+template const Target SoftmaxRegModel<TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>>::predict(const Features&) const;
+template const Probabilities SoftmaxRegModel<TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>>::predict_proba(const Features&) const;
+template void SoftmaxRegModel<TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>>::predict_into(const Features&, Target&) const;
+template void SoftmaxRegModel<TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>>::predict_proba_into(const Features&, Probabilities&) const;
@@ -20,8 +20,10 @@ StandardScaler::StandardScaler()
     name_ = Types::get_name(*this);
 }
 
-StandardScaler StandardScaler::fit(Features& X)
+StandardScaler& StandardScaler::fit(Features& X)
 {
+    EZML_PHASE(stats_, name_, "fit");
+    EZML_BYTES(stats_, "fit", 2 * X.n_rows * X.n_cols * sizeof(double));
     // 1. Compute mean and standard deviation of each feature
     means_ = arma::repmat(arma::mean(X), X.n_rows, 1);
     stddevs_ = arma::repmat(arma::stddev(X), X.n_rows, 1);
@@ -37,21 +39,52 @@ const Features StandardScaler::transform(Features& X)
     if (!is_fitted())
         throw NotFittedException(get_name());
 
+    EZML_PHASE(stats_, name_, "transform");
+    EZML_BYTES(stats_, "transform", X.n_rows * X.n_cols * sizeof(double));
     // Scale features
     return (X - means_) / stddevs_;
 }
 
+void StandardScaler::transform_into(const Features& X, Features& out) const
+{
+    // Throw if not fitted yet
+    if (!is_fitted())
+        throw NotFittedException(get_name());
+
+    EZML_TRACE_SCOPE(name_, "transform");
+    // Learned means and stddevs are the same in every row, so take the first one
+    out.set_size(X.n_rows, X.n_cols);
+    for (arma::uword j = 0; j < X.n_cols; ++j)
+        out.col(j) = (X.col(j) - means_(0, j)) / stddevs_(0, j);
+}
+
 const Features StandardScaler::fit_transform(Features& X)
 {
     return fit(X).transform(X);
 }
 
-const Features StandardScaler::get_means() const
+const ClassWeights StandardScaler::fold(const ClassWeights& W) const
+{
+    // Throw if not fitted yet
+    if (!is_fitted())
+        throw NotFittedException(get_name());
+
+    // Learned means and stddevs are the same in every row, so take the first one
+    const arma::uword d = W.n_rows - 1;
+    ClassWeights W_folded(W.n_rows, W.n_cols);
+    // 1. Scale feature weights by inverse stddevs
+    W_folded.tail_rows(d) = W.tail_rows(d).each_col() / stddevs_.row(0).t();
+    // 2. Shift intercept by weighted means
+    W_folded.row(0) = W.row(0) - means_.row(0) * W_folded.tail_rows(d);
+    return W_folded;
+}
+
+const Features& StandardScaler::get_means() const
 {
     return means_;
 }
 
-const Features StandardScaler::get_stddevs() const
+const Features& StandardScaler::get_stddevs() const
 {
     return stddevs_;
 }
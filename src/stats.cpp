@@ -0,0 +1,51 @@
+/**
+ * @file stats.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief Stats struct and ScopedTimer class implementation
+ * @version 0.1
+ * @date 2024-06-07
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include "stats.hpp"
+
+void Stats::add_bytes(const std::string& phase, const size_t bytes)
+{
+    phases[phase].bytes += bytes;
+}
+
+void Stats::add_iter(const double derivative_norm)
+{
+    ++num_iter;
+    derivative_norms.push_back(derivative_norm);
+}
+
+void Stats::reset_iters()
+{
+    num_iter = 0;
+    derivative_norms.clear();
+}
+
+void Stats::clear()
+{
+    phases.clear();
+    reset_iters();
+}
+
+ScopedTimer::ScopedTimer(Stats& stats, const std::string& owner, const char* phase)
+: phase_(stats.phases[phase])
+, owner_(owner)
+, name_(phase)
+, start_(Trace::Clock::now())
+{
+}
+
+ScopedTimer::~ScopedTimer()
+{
+    const Trace::Clock::time_point end = Trace::Clock::now();
+    phase_.seconds += std::chrono::duration<double>(end - start_).count();
+    ++phase_.calls;
+    Trace::record(owner_, name_, start_, end);
+}
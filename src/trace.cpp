@@ -0,0 +1,144 @@
+/**
+ * @file trace.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief Trace and TraceScope class implementation
+ * @version 0.1
+ * @date 2024-06-08
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+#include <unistd.h>
+#include "trace.hpp"
+#include "exceptions.hpp"
+
+namespace
+{
+    // Complete event ("ph": "X") of one thread
+    struct Event
+    {
+        std::string name;
+        size_t thread_id;
+        Trace::Clock::time_point begin;
+        Trace::Clock::time_point end;
+    };
+
+    // State of recording, events are appended under lock, flag is checked without it
+    std::atomic<bool> enabled(false);
+    std::atomic<size_t> num_threads(0);
+    std::mutex mutex;
+    std::vector<Event> events;
+    std::string trace_path;
+    Trace::Clock::time_point origin;
+
+    // Names are type names and phases, so only quotes and backslashes need escaping
+    std::string escape(const std::string& text)
+    {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (const char c : text)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    // Microseconds since start of recording
+    double micros(const Trace::Clock::time_point time)
+    {
+        return std::chrono::duration<double, std::micro>(time - origin).count();
+    }
+}
+
+void Trace::start(const std::string& path)
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    events.clear();
+    trace_path = path;
+    origin = Clock::now();
+    enabled = true;
+}
+
+void Trace::stop()
+{
+    std::vector<Event> recorded;
+    std::string path;
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (!enabled)
+            return;
+        enabled = false;
+        recorded.swap(events);
+        path = trace_path;
+    }
+
+    // Events are written after lock is released, so writing never blocks threads still finishing their spans
+    std::ofstream file(path, std::ios::trunc);
+    if (!file)
+        throw DataFileException(path, "cannot be written");
+    const long pid = static_cast<long>(::getpid());
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    for (size_t i = 0; i < recorded.size(); ++i)
+    {
+        const Event& event = recorded[i];
+        file << "{\"name\": \"" << escape(event.name) << "\", \"cat\": \"ezml\", \"ph\": \"X\""
+             << ", \"ts\": " << micros(event.begin) << ", \"dur\": " << micros(event.end) - micros(event.begin)
+             << ", \"pid\": " << pid << ", \"tid\": " << event.thread_id << "}"
+             << (i + 1 < recorded.size() ? ",\n" : "\n");
+    }
+    file << "]}\n";
+    if (!file)
+        throw DataFileException(path, "cannot be written");
+}
+
+bool Trace::is_enabled()
+{
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void Trace::record(const std::string& owner, const char* name, const Clock::time_point begin, const Clock::time_point end)
+{
+    if (!is_enabled())
+        return;
+    Event event{owner.empty() ? std::string(name) : owner + "::" + name, get_thread_id(), begin, end};
+    const std::lock_guard<std::mutex> lock(mutex);
+    if (enabled)
+        events.push_back(std::move(event));
+}
+
+size_t Trace::get_thread_id()
+{
+    thread_local const size_t thread_id = num_threads++;
+    return thread_id;
+}
+
+TraceScope::TraceScope(const char* name)
+: owner_(nullptr)
+, name_(name)
+, begin_()
+, enabled_(Trace::is_enabled())
+{
+    if (enabled_)
+        begin_ = Trace::Clock::now();
+}
+
+TraceScope::TraceScope(const std::string& owner, const char* name)
+: TraceScope(name)
+{
+    owner_ = &owner;
+}
+
+TraceScope::~TraceScope()
+{
+    if (enabled_)
+        Trace::record(owner_ ? *owner_ : std::string(), name_, begin_, Trace::Clock::now());
+}
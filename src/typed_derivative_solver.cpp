@@ -0,0 +1,508 @@
+/**
+ * @file typed_derivative_solver.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief TypedDerivativeSolver class implementation
+ * @version 0.1
+ * @date 2024-05-29
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <type_traits>
+#include <armadillo>
+#include "typed_derivative_solver.hpp"
+#include "exceptions.hpp"
+
+namespace
+{
+    // Block of rows of features fits into L2 cache, so it is scanned twice (scores, then derivative) from cache
+    constexpr size_t BLOCK_BYTES = 256 * 1024;
+    constexpr size_t MIN_BLOCK_ROWS = 64;
+    // Checkpoint file starts with magic bytes
+    constexpr char CHECKPOINT_MAGIC[8] = {'E', 'Z', 'M', 'L', 'C', 'K', 'P', '2'};
+
+    // Newton step is not row-separable, so its blocks are averaged instead of summed
+    template <typename LossType>
+    bool is_newton(const LossType& diff_loss)
+    {
+        if constexpr (std::is_same_v<LossType, DiffLoss::DynamicLoss>)
+            return diff_loss.is_newton();
+        else
+            return std::is_same_v<LossType, DiffLoss::MeanSquaredErrorLossNewton> || std::is_same_v<LossType, DiffLoss::LogLikelihoodLossNewton>;
+    }
+
+    // Progress printed with verbose flag, when no callback is set
+    bool print_iteration(const IterationInfo& info)
+    {
+        std::cout << "Iter: " << info.iter << std::endl;
+        std::cout << "Weights: " << info.weights;
+        if (info.has_loss)
+            std::cout << "Loss: " << info.loss << std::endl;
+        std::cout << "Derivative 2-norm: " << info.derivative_norm << std::endl;
+        return false;
+    }
+}
+
+template <typename LossType>
+TypedDerivativeSolver<LossType>::TypedDerivativeSolver(const double learning_rate, 
+                                                       const size_t max_iter, 
+                                                       const double min_derivative_size, 
+                                                       const bool verbose /*=false*/,
+                                                       const bool parallel /*=false*/)
+: TypedDerivativeSolver(LossType(), learning_rate, max_iter, min_derivative_size, verbose, parallel)
+{
+}
+
+template <typename LossType>
+TypedDerivativeSolver<LossType>::TypedDerivativeSolver(const LossType& diff_loss,
+                                                       const double learning_rate, 
+                                                       const size_t max_iter, 
+                                                       const double min_derivative_size, 
+                                                       const bool verbose /*=false*/,
+                                                       const bool parallel /*=false*/)
+: diff_loss_(diff_loss)
+, learning_rate_(learning_rate)
+, max_iter_(max_iter)
+, min_derivative_size_(min_derivative_size)
+, parallel_(parallel)
+, eval_every_(1)
+, patience_(1)
+, greater_is_better_(false)
+, checkpoint_every_(1)
+, best_score_(arma::datum::inf)
+, has_best_(false)
+, best_iter_(0)
+, num_bad_evals_(0)
+{
+    // Init solver here, if needed
+    verbose_ = verbose;
+    // Set solvers's name as string representation of its type
+    name_ = Types::get_name(*this);
+}
+
+template <typename LossType>
+const Derivative TypedDerivativeSolver<LossType>::compute_derivative(const Weights& w, const Features& X, const Target& y_true)
+{
+    // Reduce derivative over blocks of rows in parallel, if loss allows it
+    if constexpr (LossType::row_separable)
+    {
+        if (parallel_ && diff_loss_.is_row_separable())
+            return diff_loss_.scale(sum_partials_(w, X, y_true), X.n_rows);
+    }
+    const Derivative deriv = diff_loss_(w, X, y_true);
+    return deriv;
+}
+
+template <typename LossType>
+const Derivative TypedDerivativeSolver<LossType>::sum_partials_(const Weights& w, const Features& X, const Target& y_true) const
+{
+    // Blocks depend only on the shape of data, not on the number of threads
+    const arma::uword block_rows = std::max(MIN_BLOCK_ROWS, BLOCK_BYTES / (sizeof(double) * std::max<size_t>(X.n_cols, 1)));
+    if (!parallel_ || X.n_rows <= block_rows)
+        return diff_loss_.partial(w, X, y_true);
+
+    const size_t num_blocks = (X.n_rows + block_rows - 1) / block_rows;
+    std::vector<Derivative> partials(num_blocks);
+    // 1. Partial derivatives (X^T residuals) of blocks in parallel, BLAS is called on one block per thread
+    #pragma omp parallel
+    {
+        // Rows of block are strided in column-major X, so they are gathered into contiguous cache-sized buffer, 
+        // allocated once per thread; X is read from memory once, both products (scores, then X^T residuals) read the buffer from cache
+        Features X_block;
+        #pragma omp for schedule(static)
+        for (size_t block = 0; block < num_blocks; ++block)
+        {
+            EZML_TRACE_SCOPE(name_, "partial_derivative");
+            const arma::uword first_row = block * block_rows;
+            const arma::uword last_row = std::min(first_row + block_rows, X.n_rows) - 1;
+            X_block = X.rows(first_row, last_row);
+            // Target of block is contiguous, so it is viewed without copying
+            const Target y_block(const_cast<double*>(y_true.memptr()) + first_row, last_row - first_row + 1, false, true);
+            partials[block] = diff_loss_.partial(w, X_block, y_block);
+        }
+    }
+    // 2. Pairwise tree reduction in fixed order of blocks, so the sum is bitwise the same for any number of threads
+    for (size_t stride = 1; stride < num_blocks; stride *= 2)
+    {
+        #pragma omp parallel for schedule(static)
+        for (size_t block = 0; block < num_blocks - stride; block += 2 * stride)
+            partials[block] += partials[block + stride];
+    }
+    return partials[0];
+}
+
+template <typename LossType>
+TypedDerivativeSolver<LossType>& TypedDerivativeSolver<LossType>::set_early_stopping(const std::function<Target(const Features&, const Weights&)>& predict_func,
+                                                                                     const std::function<double(const Target&, const Target&)>& metric_func,
+                                                                                     const size_t eval_every,
+                                                                                     const size_t patience,
+                                                                                     const bool greater_is_better /*=false*/)
+{
+    predict_func_ = predict_func;
+    metric_func_ = metric_func;
+    eval_every_ = std::max<size_t>(eval_every, 1);
+    patience_ = std::max<size_t>(patience, 1);
+    greater_is_better_ = greater_is_better;
+    // Return object for possible cascading
+    return *this;
+}
+
+template <typename LossType>
+TypedDerivativeSolver<LossType>& TypedDerivativeSolver<LossType>::set_checkpoint(const std::string& path, const size_t checkpoint_every)
+{
+    checkpoint_path_ = path;
+    checkpoint_every_ = std::max<size_t>(checkpoint_every, 1);
+    // Return object for possible cascading
+    return *this;
+}
+
+template <typename LossType>
+TypedDerivativeSolver<LossType>& TypedDerivativeSolver<LossType>::set_callback(const IterationCallback& callback,
+                                                                               const std::function<Target(const Features&, const Weights&)>& predict_func /*={}*/,
+                                                                               const std::function<double(const Target&, const Target&)>& loss_func /*={}*/)
+{
+    callback_ = callback;
+    loss_predict_func_ = predict_func;
+    loss_func_ = loss_func;
+    // Return object for possible cascading
+    return *this;
+}
+
+template <typename LossType>
+const double TypedDerivativeSolver<LossType>::get_best_score() const
+{
+    return best_score_;
+}
+
+template <typename LossType>
+const size_t TypedDerivativeSolver<LossType>::get_best_iter() const
+{
+    return best_iter_;
+}
+
+template <typename LossType>
+const Weights TypedDerivativeSolver<LossType>::optimize(Weights& w, const Features& X, const Target& y)
+{
+    return descend_(w, X.n_rows, [&](const Weights& w) { return compute_derivative(w, X, y); },
+                                 [&](const Weights& w) { return loss_func_(y, loss_predict_func_(X, w)); }, nullptr, nullptr);
+}
+
+template <typename LossType>
+const Weights TypedDerivativeSolver<LossType>::optimize(Weights& w, const Features& X, const Target& y, const Features& X_val, const Target& y_val)
+{
+    // Throw if early stopping is not set
+    if (!predict_func_ || !metric_func_)
+        throw NoEarlyStoppingException(get_name());
+
+    return descend_(w, X.n_rows, [&](const Weights& w) { return compute_derivative(w, X, y); },
+                                 [&](const Weights& w) { return loss_func_(y, loss_predict_func_(X, w)); }, &X_val, &y_val);
+}
+
+template <typename LossType>
+const Weights TypedDerivativeSolver<LossType>::optimize(Weights& w, const BlockSource& source)
+{
+    const double n = static_cast<double>(source.get_num_rows());
+    Features X;
+    Target y;
+    auto derivative = [&](const Weights& w) -> Derivative
+    {
+        // One pass over blocks
+        Derivative deriv(w.n_cols, arma::fill::zeros);
+        if constexpr (LossType::row_separable)
+        {
+            // Full derivative is scaled sum of blocks' partial derivatives
+            if (diff_loss_.is_row_separable())
+            {
+                for (size_t block = 0; block < source.get_num_blocks(); ++block)
+                {
+                    source.read(block, X, y);
+                    deriv += sum_partials_(w, X, y);
+                }
+                return diff_loss_.scale(deriv, source.get_num_rows());
+            }
+        }
+        // Otherwise, Newton step (ratio of sums) is approximated by mean of blocks' steps weighted by their sizes,
+        // and any other derivative is a sum over observations, as library's gradients are, so blocks' derivatives are summed
+        const bool newton = is_newton(diff_loss_);
+        for (size_t block = 0; block < source.get_num_blocks(); ++block)
+        {
+            source.read(block, X, y);
+            deriv += compute_derivative(w, X, y) * (newton ? X.n_rows / n : 1.0);
+        }
+        return deriv;
+    };
+    auto loss = [&](const Weights& w)
+    {
+        // One pass over blocks, mean of blocks' losses weighted by their sizes
+        double total = 0.0;
+        for (size_t block = 0; block < source.get_num_blocks(); ++block)
+        {
+            source.read(block, X, y);
+            total += loss_func_(y, loss_predict_func_(X, w)) * (X.n_rows / n);
+        }
+        return total;
+    };
+    return descend_(w, source.get_num_rows(), derivative, loss, nullptr, nullptr);
+}
+
+template <typename LossType>
+template <typename DerivativeFunc, typename LossFunc>
+const Weights TypedDerivativeSolver<LossType>::descend_(Weights& w, const size_t num_rows, DerivativeFunc&& derivative, LossFunc&& loss, const Features* X_val, const Target* y_val)
+{
+    // Stopping criteria:
+    // (a) Max number of iterations has exceeded `max_iter_`
+    // (b) Derivative vector's size is less than `min_derivative_size_`
+    // (c) Validation metric has not improved for `patience_` evaluations
+    // (d) Callback has requested to stop
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const IterationCallback report = callback_ ? callback_ : (verbose_ ? IterationCallback(print_iteration) : IterationCallback());
+    const bool compute_loss = report && loss_predict_func_ && loss_func_;
+    EZML_PHASE(stats_, name_, "optimize");
+    EZML_RESET_ITERS(stats_);
+    const bool validate = X_val != nullptr;
+    const double sign = greater_is_better_ ? -1.0 : 1.0;
+    best_weights_.reset();
+    best_score_ = sign * arma::datum::inf;
+    has_best_ = false;
+    best_iter_ = 0;
+    num_bad_evals_ = 0;
+    // Resume from checkpoint, if any
+    size_t first_iter = 0;
+    const std::string fingerprint = checkpoint_path_.empty() ? std::string() : fingerprint_(num_rows);
+    if (!checkpoint_path_.empty())
+        first_iter = load_checkpoint_(w, fingerprint);
+
+    Derivative deriv;
+    for (size_t cur_iter = first_iter; cur_iter < max_iter_; ++cur_iter) // (a)
+    {
+        EZML_PHASE(stats_, name_, "iteration");
+        {
+            EZML_PHASE(stats_, name_, "derivative");
+            deriv = derivative(w);
+        }
+        const double derivative_size = arma::norm(deriv);
+        EZML_ITER(stats_, derivative_size);
+        // Loss at weights before the step, computed only if reported
+        const double cur_loss = compute_loss ? loss(w) : 0.0;
+        const bool converged = derivative_size <= min_derivative_size_;
+        if (!converged)
+            w -= learning_rate_ * deriv;
+        // Report progress, callback may request to stop
+        if (report)
+        {
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            const IterationInfo info{cur_iter, cur_loss, compute_loss, derivative_size, converged ? 0.0 : learning_rate_ * derivative_size, elapsed, w};
+            if (report(info)) // (d)
+            {
+                if (verbose_)
+                    std::cout << "\n\033[33mEarly stopping:\033[0m Requested by callback\n";
+                break;
+            }
+        }
+        if (converged) // (b)
+        {
+            if (verbose_)
+                std::cout << "\n\033[33mEarly stopping:\033[0m Derivative is no longer decreasing\n";
+            break;
+        }
+
+        // Score weights on validation data every `eval_every_` iterations, keep the best ones
+        bool out_of_patience = false;
+        if (validate && (cur_iter + 1) % eval_every_ == 0)
+        {
+            EZML_PHASE(stats_, name_, "validate");
+            const double score = metric_func_(*y_val, predict_func_(*X_val, w));
+            if (verbose_)
+                std::cout << "Validation score: " << score << std::endl;
+            // The first evaluation is always kept, since NaN checks are folded away by -ffast-math
+            if (!has_best_ || sign * score < sign * best_score_)
+            {
+                has_best_ = true;
+                best_weights_ = w;
+                best_score_ = score;
+                best_iter_ = cur_iter + 1;
+                num_bad_evals_ = 0;
+            }
+            else
+                out_of_patience = ++num_bad_evals_ >= patience_;
+        }
+        // Save state every `checkpoint_every_` iterations, so optimization can be resumed
+        if (!checkpoint_path_.empty() && (cur_iter + 1) % checkpoint_every_ == 0)
+        {
+            EZML_PHASE(stats_, name_, "checkpoint");
+            save_checkpoint_(cur_iter + 1, w, fingerprint);
+        }
+        if (out_of_patience) // (c)
+        {
+            if (verbose_)
+                std::cout << "\n\033[33mEarly stopping:\033[0m Validation score is no longer improving\n";
+            break;
+        }
+    }
+    // Optimization is complete, so it must not be resumed
+    if (!checkpoint_path_.empty())
+        std::remove(checkpoint_path_.c_str());
+    // Return the best weights seen on validation data
+    if (validate && has_best_)
+        w = best_weights_;
+    return w;
+}
+
+template <typename LossType>
+const std::string TypedDerivativeSolver<LossType>::fingerprint_(const size_t num_rows) const
+{
+    // Loss chosen at runtime is told apart by type of function it holds
+    std::string loss_name = name_;
+    if constexpr (std::is_same_v<LossType, DiffLoss::DynamicLoss>)
+        loss_name += std::string(" ") + diff_loss_.diff_loss_func.target_type().name();
+    std::ostringstream fingerprint;
+    fingerprint << loss_name << " rows=" << num_rows << " learning_rate=" << std::setprecision(17) << learning_rate_ << " max_iter=" << max_iter_;
+    return fingerprint.str();
+}
+
+template <typename LossType>
+void TypedDerivativeSolver<LossType>::save_checkpoint_(const size_t next_iter, const Weights& w, const std::string& fingerprint) const
+{
+    // Write to temporary file, then rename it, so preemption while writing never leaves broken checkpoint
+    const std::string tmp_path = checkpoint_path_ + ".tmp";
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+    const std::uint64_t header[6] = {next_iter, w.n_cols, best_weights_.n_cols, best_iter_, num_bad_evals_, fingerprint.size()};
+    file.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(fingerprint.data(), fingerprint.size());
+    file.write(reinterpret_cast<const char*>(&best_score_), sizeof(best_score_));
+    file.write(reinterpret_cast<const char*>(w.memptr()), w.n_elem * sizeof(double));
+    file.write(reinterpret_cast<const char*>(best_weights_.memptr()), best_weights_.n_elem * sizeof(double));
+    file.close();
+    if (!file || std::rename(tmp_path.c_str(), checkpoint_path_.c_str()) != 0)
+        throw DataFileException(checkpoint_path_, "can not be written");
+}
+
+template <typename LossType>
+const size_t TypedDerivativeSolver<LossType>::load_checkpoint_(Weights& w, const std::string& fingerprint)
+{
+    // No checkpoint yet, so start from the first iteration
+    std::ifstream file(checkpoint_path_, std::ios::binary);
+    if (!file)
+        return 0;
+
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    std::uint64_t header[6];
+    double best_score;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!file || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0)
+        throw DataFileException(checkpoint_path_, "is not a solver checkpoint");
+    // Checkpoint must belong to the same data, loss and solver settings, so stale checkpoint never continues other fit
+    std::string saved_fingerprint;
+    if (header[5] == fingerprint.size())
+    {
+        saved_fingerprint.resize(header[5]);
+        file.read(&saved_fingerprint[0], saved_fingerprint.size());
+    }
+    if (!file || saved_fingerprint != fingerprint)
+        throw DataFileException(checkpoint_path_, "belongs to other data, loss or solver settings");
+    file.read(reinterpret_cast<char*>(&best_score), sizeof(best_score));
+    if (header[1] != w.n_cols || (header[2] != 0 && header[2] != w.n_cols))
+        throw DataFileException(checkpoint_path_, "has weights of other shape");
+
+    Weights best_weights(header[2]);
+    file.read(reinterpret_cast<char*>(w.memptr()), w.n_elem * sizeof(double));
+    file.read(reinterpret_cast<char*>(best_weights.memptr()), best_weights.n_elem * sizeof(double));
+    if (!file)
+        throw DataFileException(checkpoint_path_, "is truncated");
+    best_weights_ = best_weights;
+    best_iter_ = header[3];
+    num_bad_evals_ = header[4];
+    best_score_ = best_score;
+    // Best weights are saved only once validation has been evaluated
+    has_best_ = !best_weights_.is_empty();
+    if (verbose_)
+        std::cout << "Resuming from checkpoint at iter: " << header[0] << std::endl;
+    return header[0];
+}
+
+// Explicitly instantiate templates for actual required types
+// MeanSquaredErrorLossGrad
+template TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>::TypedDerivativeSolver(const double, const size_t, const double, const bool, const bool);
+template TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>::TypedDerivativeSolver(const DiffLoss::MeanSquaredErrorLossGrad&, const double, const size_t, const double, const bool, const bool);
+template const Weights TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>::optimize(Weights&, const Features&, const Target&);
+template const Weights TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>::optimize(Weights&, const Features&, const Target&, const Features&, const Target&);
+template const Weights TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>::optimize(Weights&, const BlockSource&);
+template const Derivative TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>::compute_derivative(const Weights&, const Features&, const Target&);
+template TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>& TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>::set_early_stopping(const std::function<Target(const Features&, const Weights&)>&, const std::function<double(const Target&, const Target&)>&, const size_t, const size_t, const bool);
+template TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>& TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>::set_checkpoint(const std::string&, const size_t);
+template TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>& TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>::set_callback(const IterationCallback&, const std::function<Target(const Features&, const Weights&)>&, const std::function<double(const Target&, const Target&)>&);
+template const double TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>::get_best_score() const;
+template const size_t TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossGrad>::get_best_iter() const;
+// MeanSquaredErrorLossNewton
+template TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>::TypedDerivativeSolver(const double, const size_t, const double, const bool, const bool);
+template TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>::TypedDerivativeSolver(const DiffLoss::MeanSquaredErrorLossNewton&, const double, const size_t, const double, const bool, const bool);
+template const Weights TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>::optimize(Weights&, const Features&, const Target&);
+template const Weights TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>::optimize(Weights&, const Features&, const Target&, const Features&, const Target&);
+template const Weights TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>::optimize(Weights&, const BlockSource&);
+template const Derivative TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>::compute_derivative(const Weights&, const Features&, const Target&);
+template TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>& TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>::set_early_stopping(const std::function<Target(const Features&, const Weights&)>&, const std::function<double(const Target&, const Target&)>&, const size_t, const size_t, const bool);
+template TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>& TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>::set_checkpoint(const std::string&, const size_t);
+template TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>& TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>::set_callback(const IterationCallback&, const std::function<Target(const Features&, const Weights&)>&, const std::function<double(const Target&, const Target&)>&);
+template const double TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>::get_best_score() const;
+template const size_t TypedDerivativeSolver<DiffLoss::MeanSquaredErrorLossNewton>::get_best_iter() const;
+// LogLikelihoodLossGrad
+template TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>::TypedDerivativeSolver(const double, const size_t, const double, const bool, const bool);
+template TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>::TypedDerivativeSolver(const DiffLoss::LogLikelihoodLossGrad&, const double, const size_t, const double, const bool, const bool);
+template const Weights TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>::optimize(Weights&, const Features&, const Target&);
+template const Weights TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>::optimize(Weights&, const Features&, const Target&, const Features&, const Target&);
+template const Weights TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>::optimize(Weights&, const BlockSource&);
+template const Derivative TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>::compute_derivative(const Weights&, const Features&, const Target&);
+template TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>& TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>::set_early_stopping(const std::function<Target(const Features&, const Weights&)>&, const std::function<double(const Target&, const Target&)>&, const size_t, const size_t, const bool);
+template TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>& TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>::set_checkpoint(const std::string&, const size_t);
+template TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>& TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>::set_callback(const IterationCallback&, const std::function<Target(const Features&, const Weights&)>&, const std::function<double(const Target&, const Target&)>&);
+template const double TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>::get_best_score() const;
+template const size_t TypedDerivativeSolver<DiffLoss::LogLikelihoodLossGrad>::get_best_iter() const;
+// LogLikelihoodLossNewton
+template TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>::TypedDerivativeSolver(const double, const size_t, const double, const bool, const bool);
+template TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>::TypedDerivativeSolver(const DiffLoss::LogLikelihoodLossNewton&, const double, const size_t, const double, const bool, const bool);
+template const Weights TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>::optimize(Weights&, const Features&, const Target&);
+template const Weights TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>::optimize(Weights&, const Features&, const Target&, const Features&, const Target&);
+template const Weights TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>::optimize(Weights&, const BlockSource&);
+template const Derivative TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>::compute_derivative(const Weights&, const Features&, const Target&);
+template TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>& TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>::set_early_stopping(const std::function<Target(const Features&, const Weights&)>&, const std::function<double(const Target&, const Target&)>&, const size_t, const size_t, const bool);
+template TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>& TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>::set_checkpoint(const std::string&, const size_t);
+template TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>& TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>::set_callback(const IterationCallback&, const std::function<Target(const Features&, const Weights&)>&, const std::function<double(const Target&, const Target&)>&);
+template const double TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>::get_best_score() const;
+template const size_t TypedDerivativeSolver<DiffLoss::LogLikelihoodLossNewton>::get_best_iter() const;
+// CrossEntropyLossGrad
+template TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>::TypedDerivativeSolver(const double, const size_t, const double, const bool, const bool);
+template TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>::TypedDerivativeSolver(const DiffLoss::CrossEntropyLossGrad&, const double, const size_t, const double, const bool, const bool);
+template const Weights TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>::optimize(Weights&, const Features&, const Target&);
+template const Weights TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>::optimize(Weights&, const Features&, const Target&, const Features&, const Target&);
+template const Weights TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>::optimize(Weights&, const BlockSource&);
+template const Derivative TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>::compute_derivative(const Weights&, const Features&, const Target&);
+template TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>& TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>::set_early_stopping(const std::function<Target(const Features&, const Weights&)>&, const std::function<double(const Target&, const Target&)>&, const size_t, const size_t, const bool);
+template TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>& TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>::set_checkpoint(const std::string&, const size_t);
+template TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>& TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>::set_callback(const IterationCallback&, const std::function<Target(const Features&, const Weights&)>&, const std::function<double(const Target&, const Target&)>&);
+template const double TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>::get_best_score() const;
+template const size_t TypedDerivativeSolver<DiffLoss::CrossEntropyLossGrad>::get_best_iter() const;
+// DynamicLoss
+template TypedDerivativeSolver<DiffLoss::DynamicLoss>::TypedDerivativeSolver(const DiffLoss::DynamicLoss&, const double, const size_t, const double, const bool, const bool);
+template const Weights TypedDerivativeSolver<DiffLoss::DynamicLoss>::optimize(Weights&, const Features&, const Target&);
+template const Weights TypedDerivativeSolver<DiffLoss::DynamicLoss>::optimize(Weights&, const Features&, const Target&, const Features&, const Target&);
+template const Weights TypedDerivativeSolver<DiffLoss::DynamicLoss>::optimize(Weights&, const BlockSource&);
+template const Derivative TypedDerivativeSolver<DiffLoss::DynamicLoss>::compute_derivative(const Weights&, const Features&, const Target&);
+template TypedDerivativeSolver<DiffLoss::DynamicLoss>& TypedDerivativeSolver<DiffLoss::DynamicLoss>::set_early_stopping(const std::function<Target(const Features&, const Weights&)>&, const std::function<double(const Target&, const Target&)>&, const size_t, const size_t, const bool);
+template TypedDerivativeSolver<DiffLoss::DynamicLoss>& TypedDerivativeSolver<DiffLoss::DynamicLoss>::set_checkpoint(const std::string&, const size_t);
+template TypedDerivativeSolver<DiffLoss::DynamicLoss>& TypedDerivativeSolver<DiffLoss::DynamicLoss>::set_callback(const IterationCallback&, const std::function<Target(const Features&, const Weights&)>&, const std::function<double(const Target&, const Target&)>&);
+template const double TypedDerivativeSolver<DiffLoss::DynamicLoss>::get_best_score() const;
+template const size_t TypedDerivativeSolver<DiffLoss::DynamicLoss>::get_best_iter() const;
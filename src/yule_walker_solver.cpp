@@ -0,0 +1,146 @@
+/**
+ * @file yule_walker_solver.cpp
+ * @author Andrei Batyrov (arbatyrov@edu.hse.ru)
+ * @brief YuleWalkerSolver class implementation
+ * @version 0.1
+ * @date 2024-05-02
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <armadillo>
+#include "yule_walker_solver.hpp"
+#include "exceptions.hpp"
+
+YuleWalkerSolver::YuleWalkerSolver()
+: sigma_()
+, aic_()
+, bic_()
+{
+    // Init solver here
+    // Set solver's name as string representation of its type
+    name_ = Types::get_name(*this);
+}
+
+const TimeSeries YuleWalkerSolver::autocovariances(const TimeSeries& process, const size_t p)
+{
+    const size_t n = process.n_rows;
+    const TimeSeries centered = process - arma::mean(process);
+    // FFT length: power of 2, large enough to avoid circular wrap-around
+    size_t nfft = 1;
+    while (nfft < 2 * n - 1)
+        nfft <<= 1;
+    // Direct sums cost ~ n (p + 1), FFT-based (forward + inverse) costs ~ 2 nfft log2(nfft)
+    if (n * (p + 1) <= 2 * nfft * std::log2(nfft))
+    {
+        TimeSeries acov(p + 1);
+        for (size_t lag = 0; lag <= p; ++lag)
+            acov[lag] = arma::dot(centered.tail(n - lag), centered.head(n - lag)) / n;
+        return acov;
+    }
+    // Wiener-Khinchin: autocovariance is the inverse transform of power spectrum
+    const arma::cx_vec spectrum = arma::fft(centered, nfft);
+    const arma::cx_vec power = spectrum % arma::conj(spectrum);
+    const TimeSeries acov = arma::real(arma::ifft(power));
+    return acov.head(p + 1) / n;
+}
+
+const Weights YuleWalkerSolver::optimize(const TimeSeries& process, const size_t p)
+{
+    return solve_(process, p, false, Criterion::AIC);
+}
+
+const Weights YuleWalkerSolver::select_order(const TimeSeries& process, const size_t max_p, const Criterion criterion)
+{
+    return solve_(process, max_p, true, criterion);
+}
+
+const Weights YuleWalkerSolver::solve_(const TimeSeries& process, const size_t max_p, const bool select, const Criterion criterion)
+{
+    // Throw if p is too small or too large
+    if (max_p < 1 || max_p >= process.n_rows)
+        throw WrongOrderException();
+
+    const size_t n = process.n_rows;
+    TimeSeries acov;
+    {
+        EZML_PHASE(stats_, name_, "autocovariances");
+        acov = autocovariances(process, max_p);
+    }
+    // Throw if series is constant, since it has no autocorrelation to fit
+    if (acov[0] <= 0.0)
+        throw ConstantSeriesException();
+
+    EZML_PHASE(stats_, name_, "levinson");
+    aic_.set_size(max_p);
+    bic_.set_size(max_p);
+    // Levinson-Durbin recursion: for k = 1 ... p, extend AR(k - 1) solution to AR(k)
+    // phi[j - 1] holds coefficient of X_{t-j}
+    arma::dvec phi(max_p, arma::fill::zeros);
+    arma::dvec best_phi;
+    double best_variance = 0.0;
+    double best_score = 0.0;
+    double variance = acov[0];
+    // Innovation variance is kept positive, so logs of perfectly predictable series stay finite
+    const double min_variance = acov[0] * std::numeric_limits<double>::epsilon();
+    for (size_t k = 1; k <= max_p; ++k)
+    {
+        // Reflection (partial autocorrelation) coefficient
+        double acc = acov[k];
+        for (size_t j = 1; j < k; ++j)
+            acc -= phi[j - 1] * acov[k - j];
+        const double reflection = acc / variance;
+        // Update coefficients in place, pairwise from both ends
+        for (size_t j = 1; j <= (k - 1) / 2; ++j)
+        {
+            const double head = phi[j - 1];
+            const double tail = phi[k - j - 1];
+            phi[j - 1] = head - reflection * tail;
+            phi[k - j - 1] = tail - reflection * head;
+        }
+        if ((k - 1) % 2 == 1)
+        {
+            const size_t mid = (k - 1) / 2 + 1;
+            phi[mid - 1] -= reflection * phi[mid - 1];
+        }
+        phi[k - 1] = reflection;
+        variance = std::max(variance * (1.0 - reflection * reflection), min_variance);
+        // Score AR(k): k lags + intercept are estimated
+        aic_[k - 1] = n * std::log(variance) + 2.0 * (k + 1);
+        bic_[k - 1] = n * std::log(variance) + std::log(n) * (k + 1);
+        const double score = (criterion == Criterion::AIC) ? aic_[k - 1] : bic_[k - 1];
+        if (select && (k == 1 || score < best_score))
+        {
+            best_score = score;
+            best_phi = phi.head(k);
+            best_variance = variance;
+        }
+    }
+    if (!select)
+    {
+        best_phi = phi;
+        best_variance = variance;
+    }
+    sigma_ = std::sqrt(best_variance);
+
+    // Intercept: w_0 = mean (1 - sum(phi))
+    const double phi_sum = arma::sum(best_phi);
+    Weights weights(best_phi.n_rows + 1);
+    weights[0] = arma::mean(process) * (1.0 - phi_sum);
+    weights.tail(best_phi.n_rows) = best_phi.t();
+    return weights;
+}
+
+const InfoCriteria YuleWalkerSolver::get_criteria() const
+{
+    return InfoCriteria(aic_, bic_);
+}
+
+const double YuleWalkerSolver::get_sigma() const
+{
+    return sigma_;
+}